@@ -0,0 +1,55 @@
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_default_backends.h"
+
+#include "common.h"
+#include "abbreviations_data.h"
+
+
+// 32 bit FNV-1a hash, must match tools/make_abbreviations.py
+static uint32_t abbreviation_hash(char const * p_word, uint8_t len)
+{
+	uint32_t hash = 0x811C9DC5;
+
+	for (uint8_t i = 0; i < len; i++)
+	{
+		hash ^= (uint8_t)p_word[i];
+		hash *= 0x01000193;
+	}
+	return hash;
+}
+
+
+/**@brief Function for finding the expansion of an abbreviation.
+ *
+ * @param[in]   p_word   Characters of the word typed.
+ * @param[in]   len      Number of characters.
+ *
+ * @return      Null terminated expansion, or NULL if the word isn't an abbreviation.
+ */
+char const * abbreviation_find(char const * p_word, uint8_t len)
+{
+	if ((len == 0) || (len > ABBREVIATION_MAX_WORD_LEN))
+	{
+		return NULL;
+	}
+
+	uint16_t slot = abbreviation_hash(p_word, len) & (ABBREVIATION_TABLE_SIZE - 1);
+
+	while (abbreviation_table[slot][0] != ABBREVIATION_EMPTY)
+	{
+		char const * p_abbreviation = &abbreviation_strings[abbreviation_table[slot][0]];
+
+		if ((strncmp(p_abbreviation, p_word, len) == 0) && (p_abbreviation[len] == '\0'))
+		{
+			return &abbreviation_strings[abbreviation_table[slot][1]];
+		}
+		slot = (slot + 1) & (ABBREVIATION_TABLE_SIZE - 1);
+	}
+	return NULL;
+}
@@ -0,0 +1,185 @@
+// Generated by tools/make_abbreviations.py from abbreviations.txt, do not edit
+// 48 abbreviations, 128 slots, 589 bytes of strings
+
+#ifndef ABBREVIATIONS_DATA_H
+#define ABBREVIATIONS_DATA_H
+
+#define ABBREVIATION_MAX_WORD_LEN  16
+#define ABBREVIATION_TABLE_SIZE    128
+#define ABBREVIATION_EMPTY         0xFFFF
+
+// offsets of the abbreviation and its expansion in abbreviation_strings
+static const uint16_t abbreviation_table[ABBREVIATION_TABLE_SIZE][2] =
+{
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x002C, 0x0030},
+    {0x0118, 0x011B},
+    {0x0233, 0x0238},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x0017, 0x001B},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x0223, 0x0227},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x0155, 0x0159},
+    {0x0072, 0x0076},
+    {0x0180, 0x0183},
+    {0x01D3, 0x01D7},
+    {0xFFFF, 0xFFFF},
+    {0x0000, 0x0003},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x00D9, 0x00DD},
+    {0xFFFF, 0xFFFF},
+    {0x0126, 0x012A},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x01AD, 0x01B1},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x00C9, 0x00CD},
+    {0x0100, 0x0104},
+    {0x0218, 0x021C},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x0065, 0x0069},
+    {0x0045, 0x0049},
+    {0x0132, 0x0135},
+    {0x00E7, 0x00EA},
+    {0x0161, 0x0165},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x00B2, 0x00B6},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x000B, 0x000F},
+    {0xFFFF, 0xFFFF},
+    {0x0177, 0x017A},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x01B9, 0x01BD},
+    {0x0200, 0x0204},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x00A7, 0x00AB},
+    {0x01C5, 0x01CA},
+    {0x020D, 0x0211},
+    {0xFFFF, 0xFFFF},
+    {0x0050, 0x0054},
+    {0x0188, 0x018B},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x0244, 0x0247},
+    {0xFFFF, 0xFFFF},
+    {0x00BE, 0x00C2},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x005A, 0x005E},
+    {0xFFFF, 0xFFFF},
+    {0x016D, 0x0171},
+    {0x0140, 0x0144},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x009A, 0x009E},
+    {0x010B, 0x010E},
+    {0x019F, 0x01A3},
+    {0xFFFF, 0xFFFF},
+    {0x0080, 0x0084},
+    {0xFFFF, 0xFFFF},
+    {0x0038, 0x003C},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x0193, 0x0197},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x0022, 0x0026},
+    {0x00F5, 0x00F9},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x01EA, 0x01EE},
+    {0x01DF, 0x01E3},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x01F4, 0x01F8},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0x008B, 0x0090},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+    {0xFFFF, 0xFFFF},
+};
+
+static const char abbreviation_strings[589] =
+{
+    0x63, 0x6c, 0x00, 0x63, 0x6c, 0x65, 0x61, 0x72, 0x65, 0x64, 0x00, 0x63, 0x6c, 0x72, 0x00, 0x63,
+    0x6c, 0x65, 0x61, 0x72, 0x65, 0x64, 0x00, 0x64, 0x63, 0x74, 0x00, 0x64, 0x69, 0x72, 0x65, 0x63,
+    0x74, 0x00, 0x63, 0x6c, 0x62, 0x00, 0x63, 0x6c, 0x69, 0x6d, 0x62, 0x00, 0x64, 0x65, 0x73, 0x00,
+    0x64, 0x65, 0x73, 0x63, 0x65, 0x6e, 0x64, 0x00, 0x6d, 0x6e, 0x74, 0x00, 0x6d, 0x61, 0x69, 0x6e,
+    0x74, 0x61, 0x69, 0x6e, 0x00, 0x72, 0x77, 0x79, 0x00, 0x72, 0x75, 0x6e, 0x77, 0x61, 0x79, 0x00,
+    0x74, 0x77, 0x72, 0x00, 0x74, 0x6f, 0x77, 0x65, 0x72, 0x00, 0x67, 0x6e, 0x64, 0x00, 0x67, 0x72,
+    0x6f, 0x75, 0x6e, 0x64, 0x00, 0x61, 0x70, 0x70, 0x00, 0x61, 0x70, 0x70, 0x72, 0x6f, 0x61, 0x63,
+    0x68, 0x00, 0x64, 0x65, 0x70, 0x00, 0x64, 0x65, 0x70, 0x61, 0x72, 0x74, 0x75, 0x72, 0x65, 0x00,
+    0x63, 0x74, 0x72, 0x00, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x00, 0x66, 0x72, 0x65, 0x71, 0x00,
+    0x66, 0x72, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x63, 0x79, 0x00, 0x61, 0x6c, 0x74, 0x00, 0x61, 0x6c,
+    0x74, 0x69, 0x74, 0x75, 0x64, 0x65, 0x00, 0x73, 0x71, 0x6b, 0x00, 0x73, 0x71, 0x75, 0x61, 0x77,
+    0x6b, 0x00, 0x74, 0x66, 0x63, 0x00, 0x74, 0x72, 0x61, 0x66, 0x66, 0x69, 0x63, 0x00, 0x72, 0x70,
+    0x74, 0x00, 0x72, 0x65, 0x70, 0x6f, 0x72, 0x74, 0x00, 0x65, 0x73, 0x74, 0x00, 0x65, 0x73, 0x74,
+    0x61, 0x62, 0x6c, 0x69, 0x73, 0x68, 0x65, 0x64, 0x00, 0x6c, 0x6f, 0x63, 0x00, 0x6c, 0x6f, 0x63,
+    0x61, 0x6c, 0x69, 0x7a, 0x65, 0x72, 0x00, 0x67, 0x73, 0x00, 0x67, 0x6c, 0x69, 0x64, 0x65, 0x73,
+    0x6c, 0x6f, 0x70, 0x65, 0x00, 0x76, 0x69, 0x73, 0x00, 0x76, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x00,
+    0x65, 0x78, 0x70, 0x00, 0x65, 0x78, 0x70, 0x65, 0x63, 0x74, 0x00, 0x74, 0x6c, 0x00, 0x74, 0x75,
+    0x72, 0x6e, 0x20, 0x6c, 0x65, 0x66, 0x74, 0x00, 0x74, 0x72, 0x00, 0x74, 0x75, 0x72, 0x6e, 0x20,
+    0x72, 0x69, 0x67, 0x68, 0x74, 0x00, 0x74, 0x77, 0x79, 0x00, 0x74, 0x61, 0x78, 0x69, 0x77, 0x61,
+    0x79, 0x00, 0x68, 0x73, 0x00, 0x68, 0x6f, 0x6c, 0x64, 0x20, 0x73, 0x68, 0x6f, 0x72, 0x74, 0x00,
+    0x6c, 0x75, 0x77, 0x00, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x75, 0x70, 0x20, 0x61, 0x6e, 0x64, 0x20,
+    0x77, 0x61, 0x69, 0x74, 0x00, 0x74, 0x6b, 0x6f, 0x00, 0x74, 0x61, 0x6b, 0x65, 0x6f, 0x66, 0x66,
+    0x00, 0x6c, 0x64, 0x67, 0x00, 0x6c, 0x61, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x00, 0x73, 0x70, 0x64,
+    0x00, 0x73, 0x70, 0x65, 0x65, 0x64, 0x00, 0x6b, 0x74, 0x00, 0x6b, 0x6e, 0x6f, 0x74, 0x73, 0x00,
+    0x66, 0x74, 0x00, 0x66, 0x65, 0x65, 0x74, 0x00, 0x77, 0x78, 0x00, 0x77, 0x65, 0x61, 0x74, 0x68,
+    0x65, 0x72, 0x00, 0x76, 0x65, 0x63, 0x00, 0x76, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x73, 0x00, 0x69,
+    0x6e, 0x74, 0x00, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x63, 0x65, 0x70, 0x74, 0x00, 0x63, 0x74, 0x63,
+    0x00, 0x63, 0x6f, 0x6e, 0x74, 0x61, 0x63, 0x74, 0x00, 0x6d, 0x6f, 0x6e, 0x00, 0x6d, 0x6f, 0x6e,
+    0x69, 0x74, 0x6f, 0x72, 0x00, 0x61, 0x70, 0x63, 0x68, 0x00, 0x61, 0x70, 0x70, 0x72, 0x6f, 0x61,
+    0x63, 0x68, 0x00, 0x61, 0x72, 0x72, 0x00, 0x61, 0x72, 0x72, 0x69, 0x76, 0x61, 0x6c, 0x00, 0x6d,
+    0x73, 0x64, 0x00, 0x6d, 0x69, 0x73, 0x73, 0x65, 0x64, 0x00, 0x72, 0x64, 0x79, 0x00, 0x72, 0x65,
+    0x61, 0x64, 0x79, 0x00, 0x72, 0x65, 0x71, 0x00, 0x72, 0x65, 0x71, 0x75, 0x65, 0x73, 0x74, 0x00,
+    0x6e, 0x65, 0x67, 0x00, 0x6e, 0x65, 0x67, 0x61, 0x74, 0x69, 0x76, 0x65, 0x00, 0x61, 0x66, 0x66,
+    0x00, 0x61, 0x66, 0x66, 0x69, 0x72, 0x6d, 0x00, 0x75, 0x6e, 0x62, 0x00, 0x75, 0x6e, 0x61, 0x62,
+    0x6c, 0x65, 0x00, 0x69, 0x6d, 0x6d, 0x00, 0x69, 0x6d, 0x6d, 0x65, 0x64, 0x69, 0x61, 0x74, 0x65,
+    0x6c, 0x79, 0x00, 0x78, 0x70, 0x64, 0x72, 0x00, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x70, 0x6f, 0x6e,
+    0x64, 0x65, 0x72, 0x00, 0x77, 0x63, 0x00, 0x77, 0x69, 0x6c, 0x63, 0x6f, 0x00,
+};
+
+#endif // ABBREVIATIONS_DATA_H
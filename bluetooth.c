@@ -31,12 +31,16 @@
 #include "nrf_log_default_backends.h"
 
 #include "common.h"
+#include "hid_reports.h"
 
 // Name of device. Will be included in the advertising data.
 #define DEVICE_NAME                         "BinaryKeyboard"                          
 // Manufacturer. Will be passed to Device Information Service.
 #define MANUFACTURER_NAME                   "Ianstuff"                         
 
+// Record the log messages of the timer handlers and device commands as events, formatted in the idle loop or on a host (see event_trace.c)
+#define BLUETOOTH_LOG_MODE                  true
+
 // Application's BLE observer priority. You shouldn't need to modify this value.
 #define APP_BLE_OBSERVER_PRIO               3                                          
 // A tag identifying the SoftDevice BLE configuration.
@@ -72,6 +76,11 @@
 #define SLAVE_LATENCY                       6                                          
 // Connection supervisory timeout (430 ms). 
 #define CONN_SUP_TIMEOUT                    MSEC_TO_UNITS(430, UNIT_10_MS)             
+// Connection parameters for the low power profile, keys take longer to reach the host.
+#define LOW_POWER_MIN_CONN_INTERVAL         MSEC_TO_UNITS(30, UNIT_1_25_MS)
+#define LOW_POWER_MAX_CONN_INTERVAL         MSEC_TO_UNITS(60, UNIT_1_25_MS)
+#define LOW_POWER_SLAVE_LATENCY             20
+#define LOW_POWER_CONN_SUP_TIMEOUT          MSEC_TO_UNITS(4000, UNIT_10_MS)
 
 // Time from initiating event (connect or start of notification) to first time sd_ble_gap_conn_param_update is called (5 seconds). 
 #define FIRST_CONN_PARAMS_UPDATE_DELAY      APP_TIMER_TICKS(5000)                      
@@ -101,8 +110,6 @@
 #define OUTPUT_REPORT_INDEX                 0                                          
 // Maximum length of Output Report. 
 #define OUTPUT_REPORT_MAX_LEN               1                                          
-// Index of Input Report. 
-#define INPUT_REPORT_KEYS_INDEX             0                                          
 // CAPS LOCK bit in Output Report (based on 'LED Page (0x08)' of the Universal Serial Bus HID Usage Tables). 
 #define OUTPUT_REPORT_BIT_MASK_CAPS_LOCK    0x02                                       
 // Id of reference to Keyboard Input Report. 
@@ -116,75 +123,9 @@
 // Index of Feature Report. 
 #define FEATURE_REPORT_INDEX                0                                          
 
-// Number of elements that can be enqueued 
-#define MAX_BUFFER_ENTRIES                  5                                          
-
 // Version number of base USB HID Specification implemented by this application. 
 #define BASE_USB_HID_SPEC_VERSION           0x0101                                     
 
-// Maximum length of the Input Report characteristic. 
-#define INPUT_REPORT_KEYS_MAX_LEN           8                                          
-
-// Position of the modifier byte in the Input Report. 
-#define MODIFIER_KEY_POS                    0                                          
-// The start position of the key scan code in a HID Report. 
-#define SCAN_CODE_POS                       2                                          
-// Key code indicating the press of the Shift Key. 
-#define SHIFT_KEY_CODE                      0x02                                       
-
-// Maximum number of key presses that can be sent in one Input Report. 
-#define MAX_KEYS_IN_ONE_REPORT              (INPUT_REPORT_KEYS_MAX_LEN - SCAN_CODE_POS)
-
-
-/**Buffer queue access macros
- *
- * @{ */
-/** Initialization of buffer list */
-#define BUFFER_LIST_INIT()     \
-    do                         \
-    {                          \
-        buffer_list.rp    = 0; \
-        buffer_list.wp    = 0; \
-        buffer_list.count = 0; \
-    } while (0)
-
-/** Provide status of data list is full or not */
-#define BUFFER_LIST_FULL() \
-    ((MAX_BUFFER_ENTRIES == buffer_list.count - 1) ? true : false)
-
-/** Provides status of buffer list is empty or not */
-#define BUFFER_LIST_EMPTY() \
-    ((0 == buffer_list.count) ? true : false)
-
-#define BUFFER_ELEMENT_INIT(i)                 \
-    do                                         \
-    {                                          \
-        buffer_list.buffer[(i)].p_data = NULL; \
-    } while (0)
-
-
-// Abstracts buffer element
-typedef struct hid_key_buffer
-{
-    uint8_t      data_offset; // Max Data that can be buffered for all entries
-    uint8_t      data_len;    // Total length of data
-    uint8_t    * p_data;      // Scanned key pattern
-    ble_hids_t * p_instance;  // Identifies peer and service instance
-} buffer_entry_t;
-
-STATIC_ASSERT(sizeof(buffer_entry_t) % 4 == 0);
-
-// Circular buffer list
-typedef struct
-{
-    buffer_entry_t buffer[MAX_BUFFER_ENTRIES]; // Maximum number of entries that can enqueued in the list
-    uint8_t        rp;                         // Index to the read location
-    uint8_t        wp;                         // Index to write location
-    uint8_t        count;                      // Number of elements in the list
-} buffer_list_t;
-
-STATIC_ASSERT(sizeof(buffer_list_t) % 4 == 0);
-
 // Structure used to identify the HID service.
 BLE_HIDS_DEF(m_hids,                                                
              NRF_SDH_BLE_TOTAL_LINK_COUNT,
@@ -200,20 +141,21 @@ NRF_BLE_QWR_DEF(m_qwr);
 // Advertising module instance.
 BLE_ADVERTISING_DEF(m_advertising);                                 
 
-// Current protocol mode.
-static bool              m_in_boot_mode = false;                    
 // Handle of the current connection.
 static uint16_t          m_conn_handle  = BLE_CONN_HANDLE_INVALID;  
 // Variable to indicate if Caps Lock is turned on.
 static bool              m_caps_on = false;                         
 // Device reference handle to the current bonded central.
 static pm_peer_id_t      m_peer_id;
-// List to enqueue not just data to be sent, but also related information like the handle, connection handle etc
-static buffer_list_t     buffer_list;                               
-static bool              shift_mode = false;
 
 static bool bas_active = false;
 
+// Advertise to any device (not just bonded ones) once the current connection has ended.
+static bool pair_pending = false;
+
+// The low power connection parameters are in use, each connection starts with the normal ones.
+static bool low_power_mode = false;
+
 // Universally unique service identifiers.
 static ble_uuid_t m_adv_uuids[] =                                   
 {
@@ -228,6 +170,12 @@ bool bluetooth_is_connected(void)
 	return (m_conn_handle != BLE_CONN_HANDLE_INVALID);
 }
 
+// check if the host has caps lock on
+bool bluetooth_caps_lock_on(void)
+{
+	return m_caps_on;
+}
+
 static void on_hids_evt(ble_hids_t * p_hids, ble_hids_evt_t * p_evt);
 
 /**@brief Function for setting filtered whitelist.
@@ -302,6 +250,117 @@ void advertising_start(bool p_whitelist_active, bool p_clear_paired)
 }
 
 
+// restart advertising so that a new whitelist or pairing mode is used
+static void advertising_restart(void)
+{
+	if (pair_pending)
+	{
+		pair_pending = false;
+		ret_code_t err_code = ble_advertising_restart_without_whitelist(&m_advertising);
+		APP_ERROR_CHECK(err_code);
+	}
+	else
+	{
+		UNUSED_RETURN_VALUE(sd_ble_gap_adv_stop(m_advertising.adv_handle));
+		ret_code_t err_code = ble_advertising_start(&m_advertising, BLE_ADV_MODE_FAST);
+		APP_ERROR_CHECK(err_code);
+	}
+}
+
+
+// end the current connection, advertising is restarted when it has gone
+static void connection_end(void)
+{
+	if (m_conn_handle != BLE_CONN_HANDLE_INVALID)
+	{
+		ret_code_t err_code = sd_ble_gap_disconnect(m_conn_handle, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
+		if (err_code != NRF_ERROR_INVALID_STATE)
+		{
+			APP_ERROR_CHECK(err_code);
+		}
+	}
+	else
+	{
+		advertising_restart();
+	}
+}
+
+
+/**@brief Function for pairing with another device without restarting.
+ *
+ * @details Ends the current connection and advertises to any device, existing bonds are kept.
+ */
+void bluetooth_pair(void)
+{
+	EVENT_LOG(BLUETOOTH_LOG_MODE, LOG_PAIR, 0);
+	pair_pending = true;
+	connection_end();
+}
+
+
+/**@brief Function for switching to the next bonded device.
+ *
+ * @details Only the next device is in the whitelist until the keyboard is restarted or a new
+ *          bond is made.
+ */
+void bluetooth_next_peer(void)
+{
+	pm_peer_id_t peer_ids[BLE_GAP_WHITELIST_ADDR_MAX_COUNT];
+	uint32_t     peer_id_count = BLE_GAP_WHITELIST_ADDR_MAX_COUNT;
+	uint32_t     next = 0;
+
+	ret_code_t err_code = pm_peer_id_list(peer_ids, &peer_id_count, PM_PEER_ID_INVALID,
+										  PM_PEER_ID_LIST_SKIP_NO_ID_ADDR);
+	APP_ERROR_CHECK(err_code);
+
+	if (peer_id_count == 0)
+	{
+		return;
+	}
+
+	for (uint32_t i = 0; i < peer_id_count; i++)
+	{
+		if (peer_ids[i] == m_peer_id)
+		{
+			next = (i + 1) % peer_id_count;
+		}
+	}
+
+	EVENT_LOG(BLUETOOTH_LOG_MODE, LOG_NEXT_PEER, peer_ids[next]);
+	m_peer_id = peer_ids[next];
+	err_code = pm_whitelist_set(&peer_ids[next], 1);
+	APP_ERROR_CHECK(err_code);
+	connection_end();
+}
+
+
+/**@brief Function for switching the current connection between the normal and low power
+ *        connection parameters.
+ */
+void bluetooth_toggle_power_profile(void)
+{
+	ble_gap_conn_params_t conn_params;
+	bool low_power = !low_power_mode;
+
+	if (m_conn_handle == BLE_CONN_HANDLE_INVALID)
+	{
+		return;
+	}
+
+	conn_params.min_conn_interval = low_power ? LOW_POWER_MIN_CONN_INTERVAL : MIN_CONN_INTERVAL;
+	conn_params.max_conn_interval = low_power ? LOW_POWER_MAX_CONN_INTERVAL : MAX_CONN_INTERVAL;
+	conn_params.slave_latency     = low_power ? LOW_POWER_SLAVE_LATENCY : SLAVE_LATENCY;
+	conn_params.conn_sup_timeout  = low_power ? LOW_POWER_CONN_SUP_TIMEOUT : CONN_SUP_TIMEOUT;
+
+	ret_code_t err_code = ble_conn_params_change_conn_params(m_conn_handle, &conn_params);
+	EVENT_LOG(BLUETOOTH_LOG_MODE, LOG_POWER_PROFILE, EVENT_LOG_PAIR(low_power, err_code));
+	if (err_code == NRF_SUCCESS)
+	{
+		low_power_mode = low_power;
+	}
+}
+
+
 /**@brief Function for handling Peer Manager events.
  *
  * @param[in] p_evt  Peer Manager event.
@@ -381,7 +440,7 @@ void battery_level_update(uint8_t level)
 
 	if (bas_active)
 	{
-		NRF_LOG_INFO("SENDING BATTERY LEVEL: %d", level);
+		EVENT_LOG(BLUETOOTH_LOG_MODE, LOG_BATTERY_LEVEL, level);
 		err_code = ble_bas_battery_level_update(&m_bas, level, BLE_CONN_HANDLE_ALL);
 		if ((err_code != NRF_SUCCESS) &&
 			(err_code != NRF_ERROR_BUSY) &&
@@ -709,284 +768,6 @@ static void peer_manager_init(void)
 }
 
 
-/**@brief   Function for transmitting a key scan Press & Release Notification.
- *
- * @warning This handler is an example only. You need to analyze how you wish to send the key
- *          release.
- *
- * @param[in]  p_instance     Identifies the service for which Key Notifications are requested.
- * @param[in]  p_key_pattern  Pointer to key pattern.
- * @param[in]  pattern_len    Length of key pattern. 0 < pattern_len < 7.
- * @param[in]  pattern_offset Offset applied to Key Pattern for transmission.
- * @param[out] actual_len     Provides actual length of Key Pattern transmitted, making buffering of
- *                            rest possible if needed.
- * @return     NRF_SUCCESS on success, NRF_ERROR_RESOURCES in case transmission could not be
- *             completed due to lack of transmission buffer or other error codes indicating reason
- *             for failure.
- *
- * @note       In case of NRF_ERROR_RESOURCES, remaining pattern that could not be transmitted
- *             can be enqueued \ref buffer_enqueue function.
- *             In case a pattern of 'cofFEe' is the p_key_pattern, with pattern_len as 6 and
- *             pattern_offset as 0, the notifications as observed on the peer side would be
- *             1>    'c', 'o', 'f', 'F', 'E', 'e'
- *             2>    -  , 'o', 'f', 'F', 'E', 'e'
- *             3>    -  ,   -, 'f', 'F', 'E', 'e'
- *             4>    -  ,   -,   -, 'F', 'E', 'e'
- *             5>    -  ,   -,   -,   -, 'E', 'e'
- *             6>    -  ,   -,   -,   -,   -, 'e'
- *             7>    -  ,   -,   -,   -,   -,  -
- *             Here, '-' refers to release, 'c' refers to the key character being transmitted.
- *             Therefore 7 notifications will be sent.
- *             In case an offset of 4 was provided, the pattern notifications sent will be from 5-7
- *             will be transmitted.
- */
-static uint32_t send_key_scan_press_release(ble_hids_t * p_hids,
-                                            uint8_t    * p_key_pattern,
-                                            uint16_t     pattern_len,
-                                            uint16_t     pattern_offset,
-                                            uint16_t   * p_actual_len)
-{
-    ret_code_t err_code;
-    uint16_t offset;
-    uint16_t data_len;
-    uint8_t  data[INPUT_REPORT_KEYS_MAX_LEN];
-
-    // HID Report Descriptor enumerates an array of size 6, the pattern hence shall not be any
-    // longer than this.
-    STATIC_ASSERT((INPUT_REPORT_KEYS_MAX_LEN - 2) == 6);
-
-    ASSERT(pattern_len <= (INPUT_REPORT_KEYS_MAX_LEN - 2));
-
-    offset   = pattern_offset;
-    data_len = pattern_len;
-
-    do
-    {
-        // Reset the data buffer.
-        memset(data, 0, sizeof(data));
-
-        // Copy the scan code.
-        memcpy(data + SCAN_CODE_POS + offset, p_key_pattern + offset, data_len - offset);
-
-        if (shift_mode)
-        {
-            data[MODIFIER_KEY_POS] |= SHIFT_KEY_CODE;
-        }
-
-        if (!m_in_boot_mode)
-        {
-            err_code = ble_hids_inp_rep_send(p_hids,
-                                             INPUT_REPORT_KEYS_INDEX,
-                                             INPUT_REPORT_KEYS_MAX_LEN,
-                                             data,
-                                             m_conn_handle);
-        }
-        else
-        {
-            err_code = ble_hids_boot_kb_inp_rep_send(p_hids,
-                                                     INPUT_REPORT_KEYS_MAX_LEN,
-                                                     data,
-                                                     m_conn_handle);
-        }
-
-        if (err_code != NRF_SUCCESS)
-        {
-            break;
-        }
-
-        offset++;
-    }
-    while (offset <= data_len);
-
-    *p_actual_len = offset;
-
-    return err_code;
-}
-
-
-/**@brief   Function for initializing the buffer queue used to key events that could not be
- *          transmitted
- *
- * @warning This handler is an example only. You need to analyze how you wish to buffer or buffer at
- *          all.
- *
- * @note    In case of HID keyboard, a temporary buffering could be employed to handle scenarios
- *          where encryption is not yet enabled or there was a momentary link loss or there were no
- *          Transmit buffers.
- */
-static void buffer_init(void)
-{
-    uint32_t buffer_count;
-
-    BUFFER_LIST_INIT();
-
-    for (buffer_count = 0; buffer_count < MAX_BUFFER_ENTRIES; buffer_count++)
-    {
-        BUFFER_ELEMENT_INIT(buffer_count);
-    }
-}
-
-
-/**@brief Function for enqueuing key scan patterns that could not be transmitted either completely
- *        or partially.
- *
- * @warning This handler is an example only. You need to analyze how you wish to send the key
- *          release.
- *
- * @param[in]  p_hids         Identifies the service for which Key Notifications are buffered.
- * @param[in]  p_key_pattern  Pointer to key pattern.
- * @param[in]  pattern_len    Length of key pattern.
- * @param[in]  offset         Offset applied to Key Pattern when requesting a transmission on
- *                            dequeue, @ref buffer_dequeue.
- * @return     NRF_SUCCESS on success, else an error code indicating reason for failure.
- */
-static uint32_t buffer_enqueue(ble_hids_t * p_hids,
-                               uint8_t    * p_key_pattern,
-                               uint16_t     pattern_len,
-                               uint16_t     offset)
-{
-    buffer_entry_t * element;
-    uint32_t         err_code = NRF_SUCCESS;
-
-    if (BUFFER_LIST_FULL())
-    {
-        // Element cannot be buffered.
-        err_code = NRF_ERROR_NO_MEM;
-    }
-    else
-    {
-        // Make entry of buffer element and copy data.
-        element              = &buffer_list.buffer[(buffer_list.wp)];
-        element->p_instance  = p_hids;
-        element->p_data      = p_key_pattern;
-        element->data_offset = offset;
-        element->data_len    = pattern_len;
-
-        buffer_list.count++;
-        buffer_list.wp++;
-
-        if (buffer_list.wp == MAX_BUFFER_ENTRIES)
-        {
-            buffer_list.wp = 0;
-        }
-    }
-
-    return err_code;
-}
-
-
-/**@brief   Function to dequeue key scan patterns that could not be transmitted either completely of
- *          partially.
- *
- * @warning This handler is an example only. You need to analyze how you wish to send the key
- *          release.
- *
- * @param[in]  tx_flag   Indicative of whether the dequeue should result in transmission or not.
- * @note       A typical example when all keys are dequeued with transmission is when link is
- *             disconnected.
- *
- * @return     NRF_SUCCESS on success, else an error code indicating reason for failure.
- */
-static uint32_t buffer_dequeue(bool tx_flag)
-{
-    buffer_entry_t * p_element;
-    uint32_t         err_code = NRF_SUCCESS;
-    uint16_t         actual_len;
-
-    if (BUFFER_LIST_EMPTY())
-    {
-        err_code = NRF_ERROR_NOT_FOUND;
-    }
-    else
-    {
-        bool remove_element = true;
-
-        p_element = &buffer_list.buffer[(buffer_list.rp)];
-
-        if (tx_flag)
-        {
-            err_code = send_key_scan_press_release(p_element->p_instance,
-                                                   p_element->p_data,
-                                                   p_element->data_len,
-                                                   p_element->data_offset,
-                                                   &actual_len);
-            // An additional notification is needed for release of all keys, therefore check
-            // is for actual_len <= element->data_len and not actual_len < element->data_len
-            if ((err_code == NRF_ERROR_RESOURCES) && (actual_len <= p_element->data_len))
-            {
-                // Transmission could not be completed, do not remove the entry, adjust next data to
-                // be transmitted
-                p_element->data_offset = actual_len;
-                remove_element         = false;
-            }
-        }
-
-        if (remove_element)
-        {
-            BUFFER_ELEMENT_INIT(buffer_list.rp);
-
-            buffer_list.rp++;
-            buffer_list.count--;
-
-            if (buffer_list.rp == MAX_BUFFER_ENTRIES)
-            {
-                buffer_list.rp = 0;
-            }
-        }
-    }
-
-    return err_code;
-}
-
-
-/**@brief Function for sending sample key presses to the peer.
- *
- * @param[in]   key_pattern_len   Pattern length.
- * @param[in]   p_key_pattern     Pattern to be sent.
- */
-//static void keys_send(uint8_t key_pattern_len, uint8_t * p_key_pattern)
-static void keys_send(uint8_t key_pattern_len, uint8_t * p_key_pattern)
-{
-    ret_code_t err_code;
-    uint16_t actual_len;
-
-    err_code = send_key_scan_press_release(&m_hids,
-                                           p_key_pattern,
-                                           key_pattern_len,
-                                           0,
-                                           &actual_len);
-    // An additional notification is needed for release of all keys, therefore check
-    // is for actual_len <= key_pattern_len and not actual_len < key_pattern_len.
-    if ((err_code == NRF_ERROR_RESOURCES) && (actual_len <= key_pattern_len))
-    {
-        // Buffer enqueue routine return value is not intentionally checked.
-        // Rationale: Its better to have a a few keys missing than have a system
-        // reset. Recommendation is to work out most optimal value for
-        // MAX_BUFFER_ENTRIES to minimize chances of buffer queue full condition
-        UNUSED_VARIABLE(buffer_enqueue(&m_hids, p_key_pattern, key_pattern_len, actual_len));
-    }
-
-
-    if ((err_code != NRF_SUCCESS) &&
-        (err_code != NRF_ERROR_INVALID_STATE) &&
-        (err_code != NRF_ERROR_RESOURCES) &&
-        (err_code != NRF_ERROR_BUSY) &&
-        (err_code != BLE_ERROR_GATTS_SYS_ATTR_MISSING)
-       )
-    {
-        APP_ERROR_HANDLER(err_code);
-    }
-}
-
-void send_key(uint8_t key, bool shift)
-{
-	u_int8_t key_buf[1];
-	key_buf[0] = key;
-	shift_mode = shift;
-	keys_send(1, key_buf);
-}
-
-
 /**@brief Function for handling the HID Report Characteristic Write event.
  *
  * @param[in]   p_evt   HID service event.
@@ -1031,6 +812,11 @@ static void on_hid_rep_char_write(ble_hids_evt_t * p_evt)
             }
         }
     }
+    else if (p_evt->params.char_write.char_id.rep_type == BLE_HIDS_REP_TYPE_FEATURE)
+    {
+        // The feature report is used to upload macros.
+        macro_upload_write(p_evt->params.char_write.data, p_evt->params.char_write.len);
+    }
 }
 
 
@@ -1046,11 +832,11 @@ static void on_hids_evt(ble_hids_t * p_hids, ble_hids_evt_t * p_evt)
     switch (p_evt->evt_type)
     {
         case BLE_HIDS_EVT_BOOT_MODE_ENTERED:
-            m_in_boot_mode = true;
+            hid_reports_boot_mode(true);
             break;
 
         case BLE_HIDS_EVT_REPORT_MODE_ENTERED:
-            m_in_boot_mode = false;
+            hid_reports_boot_mode(false);
             break;
 
         case BLE_HIDS_EVT_REP_CHAR_WRITE:
@@ -1178,16 +964,20 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
     {
         case BLE_GAP_EVT_CONNECTED:
             NRF_LOG_INFO("Connected");
+            EVENT_PROBE(EVENT_CONNECTED, 0, 0);
 			m_conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+			low_power_mode = false;
             err_code = nrf_ble_qwr_conn_handle_assign(&m_qwr, m_conn_handle);
             APP_ERROR_CHECK(err_code);
+            hid_reports_connected(m_conn_handle);
 			set_device_state(CONNECTED);
             break;
 
         case BLE_GAP_EVT_DISCONNECTED:
             NRF_LOG_INFO("Disconnected");
+            EVENT_PROBE(EVENT_DISCONNECTED, 0, p_ble_evt->evt.gap_evt.params.disconnected.reason);
             // Dequeue all keys without transmission.
-            (void) buffer_dequeue(false);
+            hid_reports_disconnected();
 
             m_conn_handle = BLE_CONN_HANDLE_INVALID;
 
@@ -1195,6 +985,11 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
             // report containing the Caps lock state.
             m_caps_on = false;
 
+            if (pair_pending)
+            {
+                advertising_restart();
+            }
+
             break; // BLE_GAP_EVT_DISCONNECTED
 
         case BLE_GAP_EVT_PHY_UPDATE_REQUEST:
@@ -1211,7 +1006,8 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
 
         case BLE_GATTS_EVT_HVN_TX_COMPLETE:
             // Send next key event
-            (void) buffer_dequeue(true);
+            EVENT_PROBE(EVENT_TX_COMPLETE, 0, p_ble_evt->evt.gatts_evt.params.hvn_tx_complete.count);
+            hid_reports_tx_complete();
             break;
 
         case BLE_GATTC_EVT_TIMEOUT:
@@ -1315,6 +1111,6 @@ void bluetooth_init()
     hids_init();
 
     conn_params_init();
-    buffer_init();
+    hid_reports_init(&m_hids);
     peer_manager_init();
 }
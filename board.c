@@ -0,0 +1,143 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "nrf.h"
+#include "nrf_assert.h"
+#include "nrf_gpio.h"
+#include "nrf_delay.h"
+
+#include "common.h"
+
+/*
+ * Board hardware used by the keyboard, the buttons, LED and power off. The decoder in keyboard.c
+ * only reads the buttons through board_key_down() so that it can also be run on a host.
+ */
+
+#define POWER_KEY_PIN                    NRF_GPIO_PIN_MAP(0, 26)  // D9
+#define LEFT_KEY_PIN                     NRF_GPIO_PIN_MAP(0, 6)   // D11
+#define RIGHT_KEY_PIN                    NRF_GPIO_PIN_MAP(0, 8)   // D12
+#define LED_PIN                          NRF_GPIO_PIN_MAP(0, 27)  // D10
+
+static bool pair_mode = false;
+
+
+static uint32_t key_pin(enum board_key key)
+{
+	switch (key)
+	{
+	    case LEFT_KEY:
+			return LEFT_KEY_PIN;
+	    case RIGHT_KEY:
+			return RIGHT_KEY_PIN;
+	    default:
+			return POWER_KEY_PIN;
+	}
+}
+
+
+// read a button, the buttons pull the pin low when pressed
+bool board_key_down(enum board_key key)
+{
+	return !nrf_gpio_pin_read(key_pin(key));
+}
+
+
+// flash the LED quickly until a new device is paired
+void start_pair_mode(void)
+{
+	pair_mode = true;
+}
+
+
+void toggle_led(void)
+{
+	nrf_gpio_pin_toggle(LED_PIN);
+}
+
+
+/**@brief Function for putting the chip into sleep mode.
+ *
+ * @note This function will not return.
+ */
+void sleep_mode_enter(bool all_btns_wake)
+{
+    ret_code_t err_code;
+
+	// delay as the power key sense isn't debounced
+	nrf_delay_ms(30);
+
+	// set which keys will wake the device
+	nrf_gpio_cfg_sense_input(POWER_KEY_PIN, NRF_GPIO_PIN_PULLUP, NRF_GPIO_PIN_SENSE_LOW);
+	if (all_btns_wake) {
+		nrf_gpio_cfg_sense_input(LEFT_KEY_PIN, NRF_GPIO_PIN_PULLUP, NRF_GPIO_PIN_SENSE_LOW);
+		nrf_gpio_cfg_sense_input(RIGHT_KEY_PIN, NRF_GPIO_PIN_PULLUP, NRF_GPIO_PIN_SENSE_LOW);
+	}
+
+	pair_mode = false;
+
+	nrf_gpio_pin_clear(LED_PIN);
+
+    // Go to system-off mode (this function will not return; wakeup will cause a reset).
+    err_code = sd_power_system_off();
+    APP_ERROR_CHECK(err_code);
+}
+
+
+void set_device_state(enum device_state state)
+{
+	switch (state)
+	{
+	    case DISCONNECTED:
+			NRF_LOG_INFO("Event: DISCONNECTED");
+			start_led_flash_timer(pair_mode);
+			break;
+	    case CONNECTED:
+			NRF_LOG_INFO("Event: CONNECTED");
+			pair_mode = false;
+			stop_led_flash_timer();
+			nrf_gpio_pin_set(LED_PIN);
+			break;
+	    case SLEEP:
+			NRF_LOG_INFO("Event: SLEEP");
+			sleep_mode_enter(true);
+			break;
+	    case OFF:
+			NRF_LOG_INFO("Event: OFF");
+			sleep_mode_enter(false);
+			break;
+	}
+}
+
+
+// Function for initializing keys and leds
+void gpio_init(bool * p_whitelist_active, bool * p_clear_paired)
+{
+	nrf_gpio_cfg_input(POWER_KEY_PIN, NRF_GPIO_PIN_PULLUP);
+	nrf_gpio_cfg_input(LEFT_KEY_PIN, NRF_GPIO_PIN_PULLUP);
+	nrf_gpio_cfg_input(RIGHT_KEY_PIN, NRF_GPIO_PIN_PULLUP);
+
+	nrf_gpio_cfg_output(LED_PIN);
+	nrf_gpio_pin_set(LED_PIN); // set LED on at start to give some indication that the power button worked
+
+	NRF_LOG_INFO("BTN: %d %d %d", !nrf_gpio_pin_read(POWER_KEY_PIN), !nrf_gpio_pin_read(LEFT_KEY_PIN), !nrf_gpio_pin_read(RIGHT_KEY_PIN));
+
+	// check if pair mode
+	if(!nrf_gpio_pin_read(LEFT_KEY_PIN) || !nrf_gpio_pin_read(RIGHT_KEY_PIN))
+	{
+		*p_whitelist_active = false;
+		// if both buttons are pressed clear all paired devices
+		*p_clear_paired = !nrf_gpio_pin_read(LEFT_KEY_PIN) && !nrf_gpio_pin_read(RIGHT_KEY_PIN);
+		pair_mode = true;
+		NRF_LOG_INFO("PAIR MODE");
+
+		// wait for the buttons to be released
+		while (!nrf_gpio_pin_read(LEFT_KEY_PIN) || !nrf_gpio_pin_read(RIGHT_KEY_PIN));
+	}
+	else
+	{
+		*p_whitelist_active = true;
+		*p_clear_paired = false;
+		pair_mode = false;
+	}
+}
@@ -0,0 +1,359 @@
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_default_backends.h"
+
+#include "common.h"
+
+#define CALCULATOR_DECIMALS                 4             // decimal places kept in the fixed point values
+#define CALCULATOR_SCALE                    10000         // 10 ^ CALCULATOR_DECIMALS
+#define CALCULATOR_SHOW_EXPRESSION          false         // type the expression and = before the result
+#define CALCULATOR_MAX_DEPTH                8             // most brackets that can be nested
+#define CALCULATOR_LOG_MODE                 true          // record the log messages as events (see event_trace.c)
+#define CALCULATOR_ERROR_TEXT               "err"         // typed for an expression that can't be evaluated, only letters char_to_key() can type
+
+/*
+ * Expressions use + - x / and brackets with the usual precedence, plus the aviation functions
+ * (binary functions have the same precedence as x and /, times are in minutes):
+ *   distance t speed     time to fly the distance
+ *   distance s time      ground speed
+ *   speed d time         distance flown
+ *   rate f time          fuel used at a burn rate
+ *   fuel e rate          endurance
+ *   value m              feet to metres
+ *   value k              kilograms to pounds
+ */
+
+// Expression typed so far
+static char expression[CALCULATOR_MAX_EXPRESSION];
+static uint8_t expression_len = 0;
+
+// Parser state
+static uint8_t parse_pos = 0;
+static uint8_t parse_depth = 0;
+static bool parse_error = false;
+
+
+// multiply two fixed point values
+static int64_t calc_multiply(int64_t a, int64_t b)
+{
+	int64_t product;
+
+	if (__builtin_mul_overflow(a, b, &product))
+	{
+		parse_error = true;
+		return 0;
+	}
+	return (product + ((product < 0) ? -(CALCULATOR_SCALE / 2) : (CALCULATOR_SCALE / 2))) / CALCULATOR_SCALE;
+}
+
+
+// divide two fixed point values, rounding to the nearest
+static int64_t calc_divide(int64_t a, int64_t b)
+{
+	int64_t n;
+
+	if ((b == 0) || __builtin_mul_overflow(a, (int64_t)CALCULATOR_SCALE, &n))
+	{
+		parse_error = true;
+		return 0;
+	}
+
+	int64_t q = n / b;
+	int64_t r = n % b;
+	if ((r < 0 ? -r : r) * 2 >= (b < 0 ? -b : b))
+	{
+		q += ((n < 0) != (b < 0)) ? -1 : 1;
+	}
+	return q;
+}
+
+
+static char peek(void)
+{
+	return (parse_pos < expression_len) ? expression[parse_pos] : '\0';
+}
+
+
+static int64_t parse_expression(void);
+
+
+// a number, with an optional decimal point
+static int64_t parse_number(void)
+{
+	int64_t value = 0;
+	int64_t fraction = 0;
+	int64_t fraction_scale = CALCULATOR_SCALE;
+	bool digits = false;
+	bool point = false;
+
+	for (char c = peek(); ((c >= '0') && (c <= '9')) || (c == '.'); c = peek())
+	{
+		parse_pos++;
+		if (c == '.')
+		{
+			parse_error |= point;
+			point = true;
+		}
+		else if (!point)
+		{
+			if (__builtin_mul_overflow(value, (int64_t)10, &value) ||
+				__builtin_add_overflow(value, (int64_t)(c - '0'), &value))
+			{
+				parse_error = true;
+				return 0;
+			}
+			digits = true;
+		}
+		else
+		{
+			// digits past CALCULATOR_DECIMALS are dropped
+			if (fraction_scale > 1)
+			{
+				fraction_scale /= 10;
+				fraction += (c - '0') * fraction_scale;
+			}
+			digits = true;
+		}
+	}
+
+	if (!digits)
+	{
+		parse_error = true;
+		return 0;
+	}
+	if (__builtin_mul_overflow(value, (int64_t)CALCULATOR_SCALE, &value))
+	{
+		parse_error = true;
+		return 0;
+	}
+	return value + fraction;
+}
+
+
+// a number or bracketed expression, with an optional sign and unit conversions after it
+static int64_t parse_factor(void)
+{
+	int64_t value;
+
+	if (peek() == '-')
+	{
+		parse_pos++;
+		return -parse_factor();
+	}
+
+	if (peek() == '(')
+	{
+		parse_pos++;
+		if (++parse_depth > CALCULATOR_MAX_DEPTH)
+		{
+			parse_error = true;
+			return 0;
+		}
+		value = parse_expression();
+		parse_depth--;
+		if (peek() == ')')
+		{
+			parse_pos++;
+		}
+		// a missing closing bracket at the end is allowed
+	}
+	else
+	{
+		value = parse_number();
+	}
+
+	for (char c = peek(); (c == 'm') || (c == 'k'); c = peek())
+	{
+		parse_pos++;
+		value = calc_multiply(value, (c == 'm') ? 3048 : 22046);
+	}
+	return value;
+}
+
+
+// factors joined by x, / and the aviation functions
+static int64_t parse_term(void)
+{
+	int64_t value = parse_factor();
+	int64_t minutes = 60 * (int64_t)CALCULATOR_SCALE;
+
+	while (!parse_error)
+	{
+		char op = peek();
+		if ((op != 'x') && (op != '/') && (op != 't') && (op != 's') && (op != 'd') &&
+			(op != 'f') && (op != 'e'))
+		{
+			break;
+		}
+		parse_pos++;
+		int64_t rhs = parse_factor();
+
+		switch (op)
+		{
+		    case 'x':
+				value = calc_multiply(value, rhs);
+				break;
+		    case '/':
+				value = calc_divide(value, rhs);
+				break;
+		    case 't':
+		    case 'e':
+				value = calc_divide(calc_multiply(value, minutes), rhs);
+				break;
+		    case 's':
+				value = calc_multiply(calc_divide(value, rhs), minutes);
+				break;
+		    case 'd':
+		    case 'f':
+				value = calc_divide(calc_multiply(value, rhs), minutes);
+				break;
+		}
+	}
+	return value;
+}
+
+
+// terms joined by + and -
+static int64_t parse_expression(void)
+{
+	int64_t value = parse_term();
+
+	while (!parse_error && ((peek() == '+') || (peek() == '-')))
+	{
+		char op = expression[parse_pos++];
+		int64_t rhs = parse_term();
+		if ((op == '+') ? __builtin_add_overflow(value, rhs, &value) : __builtin_sub_overflow(value, rhs, &value))
+		{
+			parse_error = true;
+		}
+	}
+	return value;
+}
+
+
+// write a fixed point value as text without trailing zeros, returns the number of characters
+static uint8_t format_value(int64_t value, char * p_buf, uint8_t size)
+{
+	char digits[24];
+	uint8_t count = 0;
+	uint8_t len = 0;
+	uint64_t magnitude = (value < 0) ? -(uint64_t)value : (uint64_t)value;
+
+	do
+	{
+		digits[count++] = '0' + (magnitude % 10);
+		magnitude /= 10;
+	} while ((magnitude > 0) || (count <= CALCULATOR_DECIMALS));
+
+	// trailing zeros of the fraction aren't typed
+	uint8_t first = 0;
+	while ((first < CALCULATOR_DECIMALS) && (digits[first] == '0'))
+	{
+		first++;
+	}
+
+	if ((value < 0) && (len < size))
+	{
+		p_buf[len++] = '-';
+	}
+	for (uint8_t i = count; i > first; i--)
+	{
+		if ((i == CALCULATOR_DECIMALS) && (len < size))
+		{
+			p_buf[len++] = '.';
+		}
+		if (len < size)
+		{
+			p_buf[len++] = digits[i - 1];
+		}
+	}
+	return len;
+}
+
+
+// start a new expression
+void calculator_reset(void)
+{
+	expression_len = 0;
+}
+
+
+// add a character to the expression, returns false if it is full
+bool calculator_add_char(char c)
+{
+	if (expression_len >= CALCULATOR_MAX_EXPRESSION)
+	{
+		return false;
+	}
+	expression[expression_len++] = c;
+	return true;
+}
+
+
+// remove the last character of the expression for a backspace
+void calculator_remove_char(void)
+{
+	if (expression_len > 0)
+	{
+		expression_len--;
+	}
+}
+
+
+/**@brief Function for evaluating the expression typed.
+ *
+ * @details Uses fixed point arithmetic with CALCULATOR_DECIMALS decimal places. The expression is
+ *          cleared afterwards.
+ *
+ * @param[out]  p_buf   Text to type, the result (and the expression if CALCULATOR_SHOW_EXPRESSION is set),
+ *                      or CALCULATOR_ERROR_TEXT if the expression can't be evaluated.
+ * @param[in]   size    Size of the buffer.
+ *
+ * @return      Number of characters.
+ */
+uint8_t calculator_evaluate(char * p_buf, uint8_t size)
+{
+	uint8_t len = 0;
+
+	parse_pos = 0;
+	parse_depth = 0;
+	parse_error = false;
+
+	int64_t value = parse_expression();
+	if (parse_pos < expression_len)
+	{
+		// characters left over that aren't part of the expression
+		parse_error = true;
+	}
+
+	if (CALCULATOR_SHOW_EXPRESSION)
+	{
+		len = MIN(expression_len, size);
+		memcpy(p_buf, expression, len);
+		if (len < size)
+		{
+			p_buf[len++] = '=';
+		}
+	}
+
+	if (parse_error)
+	{
+		EVENT_LOG(CALCULATOR_LOG_MODE, LOG_CALCULATOR_ERROR, parse_pos);
+		for (char const * p_text = CALCULATOR_ERROR_TEXT; (*p_text != '\0') && (len < size); p_text++)
+		{
+			p_buf[len++] = *p_text;
+		}
+	}
+	else
+	{
+		len += format_value(value, &p_buf[len], size - len);
+	}
+
+	calculator_reset();
+	return len;
+}
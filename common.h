@@ -3,35 +3,264 @@
 
 #include "nrf_log.h"
 
-// Keyboard
+// Build profile, make PROFILE=production (the nrf52832_xxaa_production target in Keil and IAR, the
+// Production configuration in SES) sets PRODUCTION_PROFILE and switches the logger and its UART and RTT
+// backends off, so logging and tracing cost nothing
+
+#ifndef PRODUCTION_PROFILE
+#define PRODUCTION_PROFILE        0
+#endif
+
+
+// Board
 
 enum device_state { DISCONNECTED, CONNECTED, SLEEP, OFF };
 
+enum board_key { POWER_KEY, LEFT_KEY, RIGHT_KEY };
+
 void set_device_state(enum device_state state);
 
 void toggle_led(void);
 
+void start_pair_mode(void);
+
+void sleep_mode_enter(bool all_btns_wake);
+
+bool board_key_down(enum board_key key);
+
+void gpio_init(bool * p_whitelist_active, bool * p_clear_paired);
+
+
+// Keyboard
+
+// Decoder timing (in poll cycles)
+typedef struct
+{
+	uint16_t advance_time;        // time after the last release before a code is sent
+	uint16_t key_hold_time;       // time a press is held before the key repeats
+	uint8_t left_press_lockout;   // time chatter is ignored for after a press of the left button
+	uint8_t left_release_samples; // released readings needed for a release of the left button
+	uint8_t right_press_lockout;  // time chatter is ignored for after a press of the right button
+	uint8_t right_release_samples;  // released readings needed for a release of the right button
+} keyboard_timing_t;
+
 void advance_code_pos(void);
 
 void poll_keys(void);
 
-void gpio_init(bool * p_whitelist_active, bool * p_clear_paired);
+void keyboard_init(void);
+
+uint32_t get_rejected_press_count(void);
+
+uint32_t get_press_count(void);
+
+void keyboard_get_timing(keyboard_timing_t * p_timing);
+
+void keyboard_set_timing(keyboard_timing_t const * p_timing);
+
+void key_repeat(void);
 
 
 // Bluetooth
 
+#define SEND_KEYS_MAX             128           // most keys in one burst from send_keys() or send_keys_packed(), a macro can't be longer
+
 void bluetooth_init();
 
 void advertising_start(bool p_whitelist_active, bool p_clear_paired);
 
 bool bluetooth_is_connected(void);
 
-void send_key(uint8_t key, bool shift);
+bool bluetooth_caps_lock_on(void);
+
+void send_key(uint8_t key, uint8_t modifiers);
+
+void send_keys(uint8_t const * p_keys, uint8_t count);
+
+void send_keys_packed(uint8_t const * p_keys, uint8_t count);
+
+void send_key_hold(uint8_t key, uint8_t modifiers);
+
+void send_key_release(void);
 
 void battery_level_update(uint8_t level);
 
 void delete_bonds(void);
 
+void bluetooth_pair(void);
+
+void bluetooth_next_peer(void);
+
+void bluetooth_toggle_power_profile(void);
+
+
+// Macros
+
+void macros_init(uint8_t const * p_defaults, uint16_t defaults_len);
+
+bool macro_find(uint16_t code, uint8_t const ** pp_keys, uint8_t * p_count);
+
+bool macro_is_prefix(uint16_t code);
+
+void macro_upload_write(uint8_t const * p_data, uint16_t len);
+
+
+// Dictionary
+
+#define DICTIONARY_MAX_COMPLETION 24
+
+void dictionary_reset(void);
+
+void dictionary_add_char(char c);
+
+void dictionary_remove_char(void);
+
+bool dictionary_word_empty(void);
+
+uint8_t dictionary_completion(char * p_buf, uint8_t size);
+
+
+// Calculator
+
+#define CALCULATOR_MAX_EXPRESSION 32
+#define CALCULATOR_MAX_RESULT     (CALCULATOR_MAX_EXPRESSION + 24)
+
+void calculator_reset(void);
+bool calculator_add_char(char c);
+void calculator_remove_char(void);
+uint8_t calculator_evaluate(char * p_buf, uint8_t size);
+
+
+// Compose
+
+#define COMPOSE_MAX_LINE          80
+
+void compose_reset(void);
+bool compose_insert(uint8_t key, uint8_t modifiers);
+void compose_backspace(bool word);
+void compose_move(bool right, bool word);
+uint8_t compose_line(uint8_t const ** pp_keys);
+
+
+// Abbreviations
+
+#define ABBREVIATION_MAX_EXPANSION 24
+
+char const * abbreviation_find(char const * p_word, uint8_t len);
+
+
+// Press trace
+
+#define PRESS_TRACE_MODE          (!PRODUCTION_PROFILE)  // record every change in the button readings for replay on a host (see trace.c)
+#define TRACE_VERSION             1
+#define TRACE_HEADER_SIZE         10
+#define TRACE_DELTA_ESCAPE        31            // delta field of an edge when the delta follows in extra bytes
+
+void trace_init(void);
+void trace_edge(enum board_key key, bool down, uint32_t time);
+uint16_t trace_size(void);
+uint16_t trace_read(uint16_t offset, uint8_t * p_data, uint16_t len);
+void trace_dump_start(void);
+void trace_poll(void);
+
+
+// Event trace
+
+#define EVENT_TRACE_MODE          (!PRODUCTION_PROFILE)  // record when each key reaches each stage on its way to the host (see event_trace.c)
+#define EVENT_TRACE_VERSION       1
+#define EVENT_TRACE_HEADER_SIZE   10
+#define EVENT_RECORD_SIZE         8
+
+// Stages recorded, with their two arguments (the values are in dumps, so only add to the end)
+enum trace_event
+{
+	EVENT_PRESS,                  // button press accepted by the debouncer (button, -)
+	EVENT_RELEASE,                // button release accepted by the debouncer (button, -)
+	EVENT_CODE,                   // entered code processed (-, code)
+	EVENT_SEND,                   // key pattern given to the report queue (first key, keys)
+	EVENT_ACCEPT,                 // the last of a key pattern taken by the SoftDevice (first key, patterns still queued)
+	EVENT_DROP,                   // key pattern lost (EVENT_DROP_*, keys)
+	EVENT_TX_COMPLETE,            // notifications sent to the host (-, notifications)
+	EVENT_CONNECTED,              // (-, -)
+	EVENT_DISCONNECTED,           // (-, reason)
+	EVENT_LOG,                    // log message (enum log_message, value)
+};
+
+// Why a key pattern was lost
+#define EVENT_DROP_QUEUE_FULL     0             // the report queue was full
+#define EVENT_DROP_REFUSED        1             // the SoftDevice refused it, e.g. with no link
+#define EVENT_DROP_DISCONNECTED   2             // it was still queued when the link was lost
+#define EVENT_DROP_BACKLOG        3             // keys waiting for room in the report queue, never sent (the backlog was full or the link was lost)
+
+// record an event, removed when EVENT_TRACE_MODE is false
+#define EVENT_PROBE(event, arg8, arg16)                     \
+	do                                                      \
+	{                                                       \
+		if (EVENT_TRACE_MODE)                               \
+		{                                                   \
+			event_record((event), (arg8), (arg16));         \
+		}                                                   \
+	} while (0)
+
+// Log messages of the hot path, recorded as events rather than formatted there (the formats are in
+// event_trace.c, the values are in dumps so only add to the end)
+enum log_message
+{
+	LOG_PRESS_TOO_SHORT,          // press time
+	LOG_PRESS_SHORTER,            // press time
+	LOG_PRESS_SUSPECT,            // press time and gap, EVENT_LOG_PAIR()
+	LOG_ALT_KEY_MODE,
+	LOG_HOLD_TRIGGERED,
+	LOG_CODE_RESET,
+	LOG_SEND_KEY,                 // key and modifiers, EVENT_LOG_PAIR()
+	LOG_SPECULATIVE_CORRECTED,
+	LOG_CODE_CORRECTED,           // table code sent for the code entered
+	LOG_UNKNOWN_CODE,             // code
+	LOG_UNKNOWN_COMMAND,          // code
+	LOG_SEND_MACRO,               // keys
+	LOG_MODIFIERS,                // one shot and locked modifiers, EVENT_LOG_PAIR()
+	LOG_NUMERIC_LAYER,            // on
+	LOG_COMPLETE_WORD,            // keys
+	LOG_EXPAND_ABBREVIATION,      // keys
+	LOG_CALCULATOR,               // on
+	LOG_CALCULATOR_RESULT,        // keys
+	LOG_COMPOSE,                  // on
+	LOG_COMPOSE_LINE_FULL,
+	LOG_SEND_LINE,                // keys
+	LOG_ABBREVIATIONS,            // on
+	LOG_COMMAND,
+	LOG_SPECULATIVE,              // on
+	LOG_BATTERY_LEVEL,            // level (in %)
+	LOG_CALCULATOR_ERROR,         // position in the expression
+	LOG_PAIR,
+	LOG_NEXT_PEER,                // peer id
+	LOG_POWER_PROFILE,            // low power and error code, EVENT_LOG_PAIR()
+	LOG_REPORT_QUEUE_FULL,        // keys lost
+	LOG_AUTO_SPACE,               // on
+};
+
+// value of a log message with two values, each held to 255
+#define EVENT_LOG_PAIR(first, second)    ((MIN((first), 0xFF) << 8) | MIN((second), 0xFF))
+
+// record a log message, removed when the module's log mode or EVENT_TRACE_MODE is false
+#define EVENT_LOG(module_mode, message, value)              \
+	do                                                      \
+	{                                                       \
+		if ((module_mode) && EVENT_TRACE_MODE)              \
+		{                                                   \
+			event_record(EVENT_LOG, (message), (value));    \
+		}                                                   \
+	} while (0)
+
+void event_trace_init(void);
+void event_record(enum trace_event event, uint8_t arg8, uint16_t arg16);
+uint16_t event_trace_size(void);
+uint16_t event_trace_read(uint16_t offset, uint8_t * p_data, uint16_t len);
+void event_trace_dump_start(void);
+void event_trace_poll(void);
+bool event_log_format(uint8_t message, uint16_t value, char const ** pp_format, uint16_t * p_values);
+bool event_log_process(void);
+
 
 // Timers
 
@@ -45,6 +274,10 @@ void start_led_flash_timer(bool fast);
 
 void stop_led_flash_timer(void);
 
+void start_key_repeat_timer(uint32_t time);
+
+void stop_key_repeat_timer(void);
+
 
 // Battery
 
@@ -0,0 +1,135 @@
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_default_backends.h"
+
+#include "common.h"
+#include "usb_hid_keys.h"
+
+// Line being composed, a modifier byte and key code for each key (the same form as send_keys())
+static uint8_t line[COMPOSE_MAX_LINE * 2];
+static uint8_t line_len = 0;
+static uint8_t cursor = 0;
+
+
+// check if a key is part of a word, for word moves and deletes
+static bool word_key(uint8_t pos)
+{
+	uint8_t modifiers = line[pos * 2];
+	uint8_t key = line[(pos * 2) + 1];
+
+	if ((key >= KEY_A) && (key <= KEY_Z))
+	{
+		return (modifiers & ~(KEY_MOD_LSHIFT | KEY_MOD_RSHIFT)) == 0;
+	}
+	return (key >= KEY_1) && (key <= KEY_0) && (modifiers == 0);
+}
+
+
+// position of the start of the word before the cursor (skipping any spaces or punctuation first)
+static uint8_t word_start(void)
+{
+	uint8_t pos = cursor;
+
+	while ((pos > 0) && !word_key(pos - 1))
+	{
+		pos--;
+	}
+	while ((pos > 0) && word_key(pos - 1))
+	{
+		pos--;
+	}
+	return pos;
+}
+
+
+// position of the end of the word after the cursor
+static uint8_t word_end(void)
+{
+	uint8_t pos = cursor;
+
+	while ((pos < line_len) && !word_key(pos))
+	{
+		pos++;
+	}
+	while ((pos < line_len) && word_key(pos))
+	{
+		pos++;
+	}
+	return pos;
+}
+
+
+// remove the keys from a position up to the cursor
+static void remove_to_cursor(uint8_t pos)
+{
+	memmove(&line[pos * 2], &line[cursor * 2], (line_len - cursor) * 2);
+	line_len -= cursor - pos;
+	cursor = pos;
+}
+
+
+// start a new line
+void compose_reset(void)
+{
+	line_len = 0;
+	cursor = 0;
+}
+
+
+// insert a key at the cursor, returns false if the line is full
+bool compose_insert(uint8_t key, uint8_t modifiers)
+{
+	if (line_len >= COMPOSE_MAX_LINE)
+	{
+		return false;
+	}
+
+	memmove(&line[(cursor + 1) * 2], &line[cursor * 2], (line_len - cursor) * 2);
+	line[cursor * 2] = modifiers;
+	line[(cursor * 2) + 1] = key;
+	line_len++;
+	cursor++;
+	return true;
+}
+
+
+// remove the key before the cursor, or the word before it
+void compose_backspace(bool word)
+{
+	if (cursor > 0)
+	{
+		remove_to_cursor(word ? word_start() : cursor - 1);
+	}
+}
+
+
+// move the cursor a key, or a word, to the left or right
+void compose_move(bool right, bool word)
+{
+	if (right)
+	{
+		cursor = word ? word_end() : MIN(cursor + 1, line_len);
+	}
+	else
+	{
+		cursor = word ? word_start() : ((cursor > 0) ? cursor - 1 : 0);
+	}
+}
+
+
+/**@brief Function for getting the line that has been composed.
+ *
+ * @param[out]  pp_keys   Modifier byte and key code for each key in the line.
+ *
+ * @return      Number of keys.
+ */
+uint8_t compose_line(uint8_t const ** pp_keys)
+{
+	*pp_keys = line;
+	return line_len;
+}
@@ -0,0 +1,125 @@
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_default_backends.h"
+
+#include "common.h"
+#include "dictionary_data.h"
+
+#define NODE_TERMINAL                       0x80          // a word ends at the node
+#define NODE_CHILD_COUNT_MASK               0x7F
+#define NODE_BEST_HERE                      0xFF          // the best completion ends at the node
+#define NODE_HEADER_LEN                     2
+#define NODE_EDGE_LEN                       3
+
+// Nodes on the path of the current word, one for each character typed
+static uint16_t word_path[DICTIONARY_MAX_WORD_LEN + 1];
+static uint8_t word_len = 0;
+
+// Characters typed since the word left the dictionary (they only need to be counted for backspace)
+static uint8_t unmatched_len = 0;
+
+
+// find the child of a node for a character, returns false if there isn't one
+static bool find_child(uint16_t node, char c, uint16_t * p_child)
+{
+	uint8_t count = dictionary_data[node] & NODE_CHILD_COUNT_MASK;
+	uint16_t edge = node + NODE_HEADER_LEN;
+
+	for (uint8_t i = 0; i < count; i++, edge += NODE_EDGE_LEN)
+	{
+		if (dictionary_data[edge] == c)
+		{
+			*p_child = dictionary_data[edge + 1] | (dictionary_data[edge + 2] << 8);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+// start a new word
+void dictionary_reset(void)
+{
+	word_path[0] = 0;
+	word_len = 0;
+	unmatched_len = 0;
+}
+
+
+// check if no characters have been typed in the current word
+bool dictionary_word_empty(void)
+{
+	return (word_len == 0) && (unmatched_len == 0);
+}
+
+
+// follow the dictionary for the next character of the word
+void dictionary_add_char(char c)
+{
+	uint16_t child;
+
+	if ((unmatched_len == 0) && (word_len < DICTIONARY_MAX_WORD_LEN) &&
+		find_child(word_path[word_len], c, &child))
+	{
+		word_len++;
+		word_path[word_len] = child;
+	}
+	else if (unmatched_len < UINT8_MAX)
+	{
+		unmatched_len++;
+	}
+}
+
+
+// step back one character for a backspace
+void dictionary_remove_char(void)
+{
+	if (unmatched_len > 0)
+	{
+		unmatched_len--;
+	}
+	else if (word_len > 0)
+	{
+		word_len--;
+	}
+}
+
+
+/**@brief Function for finding the rest of the most likely word starting with the current word.
+ *
+ * @details Follows the best child of each node, so takes at most DICTIONARY_MAX_WORD_LEN steps.
+ *
+ * @param[out]  p_buf   Characters needed to complete the word.
+ * @param[in]   size    Size of the buffer.
+ *
+ * @return      Number of characters, 0 if there is no completion.
+ */
+uint8_t dictionary_completion(char * p_buf, uint8_t size)
+{
+	uint8_t len = 0;
+
+	if ((unmatched_len > 0) || (word_len == 0))
+	{
+		return 0;
+	}
+
+	uint16_t node = word_path[word_len];
+	while (len < size)
+	{
+		uint8_t best = dictionary_data[node + 1];
+		if (best == NODE_BEST_HERE)
+		{
+			break;
+		}
+
+		uint16_t edge = node + NODE_HEADER_LEN + (best * NODE_EDGE_LEN);
+		p_buf[len++] = dictionary_data[edge];
+		node = dictionary_data[edge + 1] | (dictionary_data[edge + 2] << 8);
+	}
+	return len;
+}
@@ -0,0 +1,265 @@
+// Generated by tools/make_dictionary.py from dictionary.txt, do not edit
+// 343 words, 623 nodes, 4027 bytes
+
+#ifndef DICTIONARY_DATA_H
+#define DICTIONARY_DATA_H
+
+#define DICTIONARY_MAX_WORD_LEN  24
+
+static const uint8_t dictionary_data[4027] =
+{
+    0x1a, 0x02, 0x61, 0x50, 0x00, 0x62, 0x70, 0x00, 0x63, 0x7e, 0x00, 0x64, 0x95, 0x00, 0x65, 0xa9,
+    0x00, 0x66, 0xc0, 0x00, 0x67, 0xd4, 0x00, 0x68, 0xee, 0x00, 0x69, 0xfc, 0x00, 0x6a, 0x0d, 0x01,
+    0x6b, 0x15, 0x01, 0x6c, 0x1d, 0x01, 0x6d, 0x2b, 0x01, 0x6e, 0x39, 0x01, 0x6f, 0x4d, 0x01, 0x70,
+    0x64, 0x01, 0x71, 0x75, 0x01, 0x72, 0x80, 0x01, 0x73, 0x94, 0x01, 0x74, 0xb7, 0x01, 0x75, 0xd1,
+    0x01, 0x76, 0xd9, 0x01, 0x77, 0xe7, 0x01, 0x78, 0xf5, 0x01, 0x79, 0xfa, 0x01, 0x7a, 0xff, 0x01,
+    0x0a, 0x06, 0x63, 0x0a, 0x02, 0x64, 0x0f, 0x02, 0x66, 0x14, 0x02, 0x67, 0x1c, 0x02, 0x69, 0x21,
+    0x02, 0x6c, 0x26, 0x02, 0x70, 0x31, 0x02, 0x72, 0x39, 0x02, 0x74, 0x41, 0x02, 0x76, 0x46, 0x02,
+    0x04, 0x01, 0x61, 0x4b, 0x02, 0x65, 0x53, 0x02, 0x6f, 0x5e, 0x02, 0x72, 0x69, 0x02, 0x07, 0x04,
+    0x61, 0x74, 0x02, 0x65, 0x7f, 0x02, 0x68, 0x8a, 0x02, 0x69, 0x92, 0x02, 0x6c, 0x97, 0x02, 0x6f,
+    0xa5, 0x02, 0x72, 0xb6, 0x02, 0x06, 0x01, 0x61, 0xbe, 0x02, 0x65, 0xc3, 0x02, 0x69, 0xda, 0x02,
+    0x6d, 0xe5, 0x02, 0x6f, 0xea, 0x02, 0x72, 0xef, 0x02, 0x07, 0x05, 0x61, 0xf7, 0x02, 0x63, 0xfc,
+    0x02, 0x69, 0x01, 0x03, 0x6d, 0x06, 0x03, 0x6e, 0x0b, 0x03, 0x73, 0x13, 0x03, 0x78, 0x18, 0x03,
+    0x06, 0x04, 0x65, 0x23, 0x03, 0x69, 0x2b, 0x03, 0x6c, 0x36, 0x03, 0x6f, 0x3e, 0x03, 0x72, 0x4c,
+    0x03, 0x75, 0x51, 0x03, 0x08, 0x06, 0x61, 0x59, 0x03, 0x65, 0x5e, 0x03, 0x6c, 0x63, 0x03, 0x6e,
+    0x68, 0x03, 0x6f, 0x6d, 0x03, 0x70, 0x75, 0x03, 0x72, 0x7a, 0x03, 0x75, 0x7f, 0x03, 0x04, 0x01,
+    0x61, 0x84, 0x03, 0x65, 0x8c, 0x03, 0x6f, 0x97, 0x03, 0x75, 0xa2, 0x03, 0x05, 0x04, 0x63, 0xa7,
+    0x03, 0x64, 0xaf, 0x03, 0x6c, 0x75, 0x03, 0x6d, 0xb4, 0x03, 0x6e, 0xb9, 0x03, 0x02, 0x00, 0x6f,
+    0xcd, 0x03, 0x75, 0xd2, 0x03, 0x02, 0x01, 0x69, 0xd7, 0x03, 0x6e, 0xdc, 0x03, 0x04, 0x01, 0x61,
+    0xe1, 0x03, 0x65, 0xe6, 0x03, 0x69, 0xf1, 0x03, 0x6f, 0xfc, 0x03, 0x04, 0x00, 0x61, 0x01, 0x04,
+    0x65, 0x0c, 0x04, 0x69, 0x14, 0x04, 0x6f, 0x25, 0x04, 0x06, 0x02, 0x61, 0x2d, 0x04, 0x64, 0x35,
+    0x04, 0x65, 0x3a, 0x04, 0x69, 0x3f, 0x04, 0x6f, 0x44, 0x04, 0x75, 0x4c, 0x04, 0x07, 0x05, 0x6e,
+    0xe5, 0x02, 0x70, 0x51, 0x04, 0x72, 0x56, 0x04, 0x73, 0x5b, 0x04, 0x75, 0x60, 0x04, 0x76, 0x65,
+    0x04, 0x77, 0x6a, 0x04, 0x05, 0x00, 0x61, 0x6f, 0x04, 0x69, 0x80, 0x04, 0x6f, 0x88, 0x04, 0x72,
+    0x96, 0x04, 0x75, 0x9e, 0x04, 0x03, 0x01, 0x66, 0xe5, 0x02, 0x6e, 0xa6, 0x04, 0x75, 0xab, 0x04,
+    0x06, 0x05, 0x61, 0xb0, 0x04, 0x65, 0xb8, 0x04, 0x69, 0xc9, 0x04, 0x6e, 0xd1, 0x04, 0x6f, 0xd9,
+    0x04, 0x75, 0xe1, 0x04, 0x0b, 0x08, 0x61, 0xe6, 0x04, 0x63, 0xeb, 0x04, 0x65, 0xf0, 0x04, 0x68,
+    0xfe, 0x04, 0x69, 0x06, 0x05, 0x6e, 0x0e, 0x05, 0x6f, 0x13, 0x05, 0x70, 0x18, 0x05, 0x71, 0x1d,
+    0x05, 0x74, 0x22, 0x05, 0x75, 0x2d, 0x05, 0x08, 0x04, 0x61, 0x32, 0x05, 0x65, 0x40, 0x05, 0x68,
+    0x48, 0x05, 0x69, 0x53, 0x05, 0x6f, 0x58, 0x05, 0x72, 0x60, 0x05, 0x75, 0x6b, 0x05, 0x77, 0x70,
+    0x05, 0x02, 0x00, 0x6e, 0x75, 0x05, 0x70, 0x80, 0x05, 0x04, 0x02, 0x61, 0x85, 0x05, 0x65, 0x8d,
+    0x05, 0x69, 0x92, 0x05, 0x6f, 0x9d, 0x05, 0x04, 0x00, 0x61, 0xa2, 0x05, 0x65, 0xad, 0x05, 0x68,
+    0xb8, 0x05, 0x69, 0xbd, 0x05, 0x01, 0x00, 0x72, 0xc5, 0x05, 0x01, 0x00, 0x61, 0xca, 0x05, 0x03,
+    0x02, 0x65, 0xcf, 0x05, 0x6f, 0x3f, 0x04, 0x75, 0xd4, 0x05, 0x01, 0x00, 0x74, 0xd9, 0x05, 0x01,
+    0x00, 0x76, 0xde, 0x05, 0x02, 0x01, 0x66, 0xe3, 0x05, 0x74, 0xe8, 0x05, 0x01, 0x00, 0x61, 0xcd,
+    0x03, 0x01, 0x00, 0x72, 0xed, 0x05, 0x03, 0x02, 0x65, 0xfb, 0x05, 0x70, 0x00, 0x06, 0x74, 0x05,
+    0x06, 0x02, 0x00, 0x70, 0x0d, 0x06, 0x72, 0x12, 0x06, 0x02, 0x01, 0x6f, 0x17, 0x06, 0x72, 0x1c,
+    0x06, 0x01, 0x00, 0x69, 0x75, 0x03, 0x01, 0x00, 0x6f, 0x21, 0x06, 0x02, 0x01, 0x63, 0x26, 0x06,
+    0x73, 0xe5, 0x02, 0x03, 0x01, 0x61, 0x2b, 0x06, 0x66, 0x33, 0x06, 0x68, 0x38, 0x06, 0x03, 0x00,
+    0x61, 0x3d, 0x06, 0x65, 0x42, 0x06, 0x75, 0x47, 0x06, 0x03, 0x02, 0x61, 0x4c, 0x06, 0x69, 0x54,
+    0x06, 0x6f, 0x59, 0x06, 0x03, 0x02, 0x6c, 0x5e, 0x06, 0x72, 0x63, 0x06, 0x75, 0x68, 0x06, 0x03,
+    0x01, 0x69, 0x6d, 0x06, 0x6e, 0x72, 0x06, 0x73, 0x77, 0x06, 0x02, 0x00, 0x61, 0x7c, 0x06, 0x65,
+    0x84, 0x06, 0x01, 0x00, 0x72, 0x89, 0x06, 0x04, 0x01, 0x61, 0x68, 0x03, 0x65, 0x8e, 0x06, 0x69,
+    0x93, 0x06, 0x6f, 0x98, 0x06, 0x05, 0x02, 0x64, 0xe5, 0x02, 0x6d, 0xa0, 0x06, 0x6e, 0xa5, 0x06,
+    0x72, 0xad, 0x06, 0x75, 0xb2, 0x06, 0x02, 0x00, 0x6f, 0xb7, 0x06, 0x75, 0xbc, 0x06, 0x01, 0x00,
+    0x6e, 0xc1, 0x06, 0x07, 0x05, 0x63, 0xc6, 0x06, 0x67, 0xcb, 0x06, 0x6c, 0xd0, 0x06, 0x6e, 0xdb,
+    0x06, 0x70, 0xe0, 0x06, 0x73, 0xe5, 0x06, 0x77, 0xed, 0x06, 0x03, 0x00, 0x72, 0xf2, 0x06, 0x73,
+    0xf7, 0x06, 0x76, 0x02, 0x07, 0x01, 0x00, 0x65, 0x07, 0x07, 0x01, 0x00, 0x77, 0x09, 0x07, 0x02,
+    0x01, 0x69, 0x0e, 0x07, 0x79, 0x07, 0x07, 0x01, 0x00, 0x73, 0x13, 0x07, 0x01, 0x00, 0x68, 0x70,
+    0x05, 0x01, 0x00, 0x67, 0x18, 0x07, 0x01, 0x00, 0x65, 0x1d, 0x07, 0x02, 0x00, 0x67, 0x22, 0x07,
+    0x74, 0x27, 0x07, 0x01, 0x00, 0x74, 0x2c, 0x07, 0x03, 0x01, 0x69, 0x13, 0x07, 0x70, 0x34, 0x07,
+    0x74, 0x39, 0x07, 0x02, 0x00, 0x65, 0x13, 0x07, 0x77, 0x07, 0x07, 0x03, 0x00, 0x6e, 0x3e, 0x07,
+    0x76, 0xe5, 0x02, 0x78, 0x07, 0x07, 0x02, 0x01, 0x61, 0x43, 0x07, 0x69, 0x01, 0x03, 0x04, 0x00,
+    0x67, 0x07, 0x07, 0x6c, 0x48, 0x07, 0x75, 0x9d, 0x05, 0x78, 0x4d, 0x07, 0x01, 0x00, 0x65, 0x52,
+    0x07, 0x02, 0x01, 0x65, 0x57, 0x07, 0x72, 0x5c, 0x07, 0x01, 0x00, 0x74, 0xe5, 0x02, 0x01, 0x00,
+    0x61, 0x9d, 0x05, 0x01, 0x00, 0x69, 0x61, 0x07, 0x01, 0x00, 0x73, 0x75, 0x03, 0x82, 0xff, 0x6c,
+    0x66, 0x07, 0x6f, 0x6b, 0x07, 0x01, 0x00, 0x73, 0x07, 0x07, 0x01, 0x00, 0x6f, 0x70, 0x07, 0x01,
+    0x00, 0x73, 0x75, 0x07, 0x02, 0x01, 0x6e, 0x7a, 0x07, 0x7a, 0xe5, 0x02, 0x03, 0x00, 0x61, 0x7f,
+    0x07, 0x63, 0x8a, 0x07, 0x6c, 0x8f, 0x07, 0x03, 0x00, 0x6c, 0x94, 0x07, 0x74, 0x99, 0x07, 0x75,
+    0x9e, 0x07, 0x01, 0x00, 0x6e, 0xa3, 0x07, 0x02, 0x01, 0x65, 0x07, 0x07, 0x69, 0xa8, 0x07, 0x01,
+    0x00, 0x65, 0xad, 0x07, 0x01, 0x00, 0x6d, 0xb2, 0x07, 0x06, 0x02, 0x61, 0xb7, 0x07, 0x62, 0xbc,
+    0x07, 0x63, 0xc1, 0x07, 0x64, 0xc9, 0x07, 0x66, 0xce, 0x07, 0x74, 0xd3, 0x07, 0x01, 0x00, 0x69,
+    0x6a, 0x04, 0x01, 0x00, 0x6c, 0xd8, 0x07, 0x01, 0x00, 0x6c, 0x70, 0x05, 0x01, 0x00, 0x6f, 0xdd,
+    0x07, 0x01, 0x00, 0x6e, 0xe2, 0x07, 0x03, 0x02, 0x61, 0xe7, 0x07, 0x66, 0x13, 0x07, 0x76, 0xef,
+    0x07, 0x03, 0x02, 0x67, 0xf4, 0x07, 0x6d, 0xf9, 0x07, 0x6e, 0xfe, 0x07, 0x01, 0x00, 0x63, 0x03,
+    0x08, 0x03, 0x01, 0x67, 0x08, 0x08, 0x69, 0x0d, 0x08, 0x79, 0x12, 0x08, 0x02, 0x00, 0x64, 0x17,
+    0x08, 0x72, 0x1c, 0x08, 0x05, 0x03, 0x6b, 0xe5, 0x02, 0x6c, 0x21, 0x08, 0x6e, 0x29, 0x08, 0x73,
+    0x31, 0x08, 0x78, 0x39, 0x08, 0x02, 0x00, 0x64, 0x3e, 0x08, 0x6e, 0x43, 0x08, 0x02, 0x00, 0x75,
+    0x48, 0x08, 0x76, 0x4d, 0x08, 0x01, 0x00, 0x62, 0x07, 0x07, 0x01, 0x00, 0x67, 0x52, 0x08, 0x01,
+    0x00, 0x6e, 0xe5, 0x02, 0x02, 0x00, 0x72, 0x57, 0x08, 0x76, 0x5c, 0x08, 0x01, 0x00, 0x6d, 0x61,
+    0x08, 0x01, 0x00, 0x65, 0x6a, 0x04, 0x01, 0x00, 0x62, 0x66, 0x08, 0x01, 0x00, 0x63, 0x5e, 0x03,
+    0x01, 0x00, 0x74, 0x6b, 0x08, 0x01, 0x00, 0x65, 0x70, 0x08, 0x01, 0x00, 0x6e, 0x07, 0x07, 0x05,
+    0x04, 0x6e, 0x07, 0x07, 0x70, 0xf9, 0x07, 0x72, 0x75, 0x08, 0x73, 0x7a, 0x08, 0x74, 0x7f, 0x08,
+    0x02, 0x00, 0x6c, 0x84, 0x08, 0x70, 0xe8, 0x05, 0x04, 0x02, 0x69, 0x89, 0x08, 0x6f, 0x9d, 0x05,
+    0x73, 0x8e, 0x08, 0x77, 0xe8, 0x05, 0x02, 0x01, 0x65, 0x93, 0x08, 0x6f, 0x9b, 0x08, 0x02, 0x01,
+    0x6c, 0x57, 0x07, 0x73, 0xa3, 0x08, 0x01, 0x00, 0x68, 0x07, 0x07, 0x01, 0x00, 0x65, 0xa8, 0x08,
+    0x02, 0x00, 0x64, 0xad, 0x08, 0x69, 0x6a, 0x04, 0x05, 0x02, 0x61, 0xb5, 0x08, 0x64, 0xbd, 0x08,
+    0x70, 0xc2, 0x08, 0x71, 0xc7, 0x08, 0x73, 0xcc, 0x08, 0x02, 0x01, 0x63, 0xa6, 0x04, 0x67, 0x18,
+    0x07, 0x02, 0x00, 0x61, 0xd7, 0x08, 0x70, 0x07, 0x07, 0x02, 0x00, 0x67, 0xe8, 0x05, 0x6d, 0xdc,
+    0x08, 0x01, 0x00, 0x6e, 0xe1, 0x08, 0x01, 0x00, 0x79, 0x07, 0x07, 0x01, 0x00, 0x61, 0xe9, 0x08,
+    0x04, 0x03, 0x63, 0xee, 0x08, 0x71, 0xf3, 0x08, 0x72, 0xf8, 0x08, 0x76, 0xfd, 0x08, 0x02, 0x01,
+    0x65, 0x5e, 0x03, 0x6f, 0x02, 0x09, 0x02, 0x00, 0x65, 0x0a, 0x09, 0x78, 0x07, 0x07, 0x01, 0x00,
+    0x6f, 0x0f, 0x09, 0x01, 0x00, 0x75, 0x14, 0x09, 0x01, 0x00, 0x65, 0x1c, 0x09, 0x01, 0x00, 0x75,
+    0x21, 0x09, 0x03, 0x00, 0x61, 0x26, 0x09, 0x6f, 0x2e, 0x09, 0x72, 0x33, 0x09, 0x01, 0x00, 0x70,
+    0xe8, 0x05, 0x04, 0x03, 0x69, 0x38, 0x09, 0x6b, 0x3d, 0x09, 0x6e, 0x42, 0x09, 0x78, 0x47, 0x09,
+    0x02, 0x01, 0x6d, 0x4c, 0x09, 0x72, 0x51, 0x09, 0x03, 0x00, 0x6f, 0x59, 0x09, 0x72, 0x5e, 0x09,
+    0x75, 0x66, 0x09, 0x01, 0x00, 0x6d, 0xe5, 0x02, 0x02, 0x01, 0x75, 0x6b, 0x09, 0x77, 0xe8, 0x05,
+    0x03, 0x00, 0x61, 0x70, 0x09, 0x69, 0x5e, 0x06, 0x75, 0xe5, 0x02, 0x01, 0x00, 0x72, 0x7b, 0x09,
+    0x01, 0x00, 0x6f, 0x07, 0x07, 0x03, 0x02, 0x61, 0x83, 0x09, 0x69, 0x88, 0x09, 0x74, 0x8d, 0x09,
+    0x81, 0x00, 0x77, 0x38, 0x06, 0x02, 0x00, 0x63, 0x92, 0x09, 0x72, 0x97, 0x09, 0x01, 0x00, 0x63,
+    0x9c, 0x09, 0x03, 0x02, 0x61, 0x07, 0x07, 0x63, 0xee, 0x08, 0x73, 0xa1, 0x09, 0x01, 0x00, 0x72,
+    0x07, 0x07, 0x03, 0x00, 0x69, 0x13, 0x07, 0x6b, 0xe5, 0x02, 0x79, 0xed, 0x06, 0x03, 0x00, 0x61,
+    0x5c, 0x07, 0x73, 0x13, 0x07, 0x74, 0x07, 0x07, 0x01, 0x00, 0x69, 0xa9, 0x09, 0x02, 0x01, 0x6c,
+    0xae, 0x09, 0x6e, 0xb3, 0x09, 0x01, 0x00, 0x61, 0xe6, 0x04, 0x01, 0x00, 0x6e, 0xb8, 0x09, 0x01,
+    0x00, 0x72, 0x70, 0x05, 0x01, 0x00, 0x6c, 0xbd, 0x09, 0x01, 0x00, 0x69, 0xc2, 0x09, 0x01, 0x00,
+    0x69, 0xca, 0x09, 0x01, 0x00, 0x69, 0xcf, 0x09, 0x01, 0x00, 0x65, 0x9d, 0x05, 0x04, 0x03, 0x62,
+    0xd4, 0x09, 0x63, 0xd9, 0x09, 0x73, 0xde, 0x09, 0x77, 0xc5, 0x05, 0x01, 0x00, 0x72, 0x13, 0x07,
+    0x01, 0x00, 0x68, 0xf9, 0x07, 0x02, 0x01, 0x65, 0xe3, 0x09, 0x69, 0xe8, 0x09, 0x01, 0x00, 0x72,
+    0xf0, 0x09, 0x01, 0x00, 0x6f, 0x6a, 0x04, 0x01, 0x00, 0x75, 0xf5, 0x09, 0x01, 0x00, 0x69, 0xfa,
+    0x09, 0x01, 0x00, 0x69, 0xff, 0x09, 0x01, 0x00, 0x6b, 0x04, 0x0a, 0x02, 0x01, 0x63, 0x12, 0x06,
+    0x72, 0x42, 0x06, 0x01, 0x00, 0x6f, 0x09, 0x0a, 0x01, 0x00, 0x69, 0xf5, 0x09, 0x01, 0x00, 0x72,
+    0x6b, 0x07, 0x01, 0x00, 0x69, 0xa8, 0x07, 0x01, 0x00, 0x6e, 0x0e, 0x0a, 0x02, 0x00, 0x6b, 0x42,
+    0x06, 0x76, 0x70, 0x05, 0x01, 0x00, 0x65, 0x13, 0x0a, 0x01, 0x00, 0x6b, 0x51, 0x04, 0x01, 0x00,
+    0x6d, 0x07, 0x07, 0x01, 0x00, 0x62, 0x18, 0x0a, 0x01, 0x00, 0x74, 0x1d, 0x0a, 0x01, 0x00, 0x6c,
+    0x42, 0x06, 0x01, 0x00, 0x74, 0xe8, 0x05, 0x01, 0x00, 0x73, 0x22, 0x0a, 0x02, 0x00, 0x6e, 0x27,
+    0x0a, 0x72, 0x2c, 0x0a, 0x01, 0x00, 0x63, 0x31, 0x0a, 0x01, 0x00, 0x63, 0x36, 0x0a, 0x01, 0x00,
+    0x61, 0x3b, 0x0a, 0x01, 0x00, 0x6d, 0x40, 0x0a, 0x02, 0x01, 0x73, 0x1c, 0x09, 0x75, 0x45, 0x0a,
+    0x01, 0x00, 0x70, 0x4a, 0x0a, 0x02, 0x01, 0x66, 0x52, 0x0a, 0x74, 0x5a, 0x0a, 0x01, 0x00, 0x72,
+    0xf2, 0x06, 0x01, 0x00, 0x72, 0x65, 0x0a, 0x01, 0x00, 0x73, 0x6a, 0x0a, 0x01, 0x00, 0x69, 0x65,
+    0x0a, 0x01, 0x00, 0x67, 0xe8, 0x05, 0x01, 0x00, 0x69, 0x6f, 0x0a, 0x01, 0x00, 0x72, 0x74, 0x0a,
+    0x03, 0x00, 0x61, 0xe6, 0x04, 0x69, 0x79, 0x0a, 0x74, 0xf9, 0x07, 0x01, 0x00, 0x69, 0x1c, 0x09,
+    0x01, 0x00, 0x61, 0x7e, 0x0a, 0x02, 0x00, 0x63, 0x83, 0x0a, 0x74, 0x88, 0x0a, 0x01, 0x00, 0x70,
+    0x8d, 0x0a, 0x01, 0x00, 0x65, 0x92, 0x0a, 0x03, 0x02, 0x63, 0x97, 0x0a, 0x70, 0x9c, 0x0a, 0x74,
+    0xa1, 0x0a, 0x01, 0x00, 0x65, 0xa6, 0x0a, 0x80, 0xff, 0x01, 0x00, 0x6e, 0x80, 0x05, 0x01, 0x00,
+    0x7a, 0xab, 0x0a, 0x01, 0x00, 0x74, 0x07, 0x07, 0x01, 0x00, 0x68, 0x13, 0x07, 0x01, 0x00, 0x72,
+    0xb0, 0x0a, 0x01, 0x00, 0x69, 0xb5, 0x0a, 0x01, 0x00, 0x72, 0xe6, 0x04, 0x02, 0x00, 0x61, 0xba,
+    0x0a, 0x69, 0xbf, 0x0a, 0x01, 0x00, 0x65, 0xc4, 0x0a, 0x01, 0x00, 0x65, 0xf5, 0x09, 0x01, 0x00,
+    0x61, 0x57, 0x07, 0x01, 0x00, 0x70, 0x75, 0x03, 0x01, 0x00, 0x6c, 0xcc, 0x0a, 0x01, 0x00, 0x74,
+    0xd1, 0x0a, 0x01, 0x00, 0x71, 0xd6, 0x0a, 0x01, 0x00, 0x6c, 0x07, 0x07, 0x01, 0x00, 0x74, 0xdb,
+    0x0a, 0x01, 0x00, 0x64, 0xe0, 0x0a, 0x01, 0x00, 0x66, 0x07, 0x07, 0x01, 0x00, 0x64, 0x07, 0x07,
+    0x01, 0x00, 0x75, 0xe5, 0x0a, 0x01, 0x00, 0x74, 0xea, 0x0a, 0x01, 0x00, 0x64, 0xf2, 0x0a, 0x03,
+    0x00, 0x64, 0xf7, 0x0a, 0x74, 0x07, 0x07, 0x76, 0xe6, 0x04, 0x01, 0x00, 0x74, 0xff, 0x0a, 0x01,
+    0x00, 0x69, 0x04, 0x0b, 0x01, 0x00, 0x64, 0x09, 0x0b, 0x01, 0x00, 0x65, 0x57, 0x07, 0x01, 0x00,
+    0x72, 0x75, 0x03, 0x01, 0x00, 0x64, 0x0e, 0x0b, 0x01, 0x00, 0x6e, 0x13, 0x0b, 0x01, 0x00, 0x6e,
+    0x18, 0x0b, 0x01, 0x00, 0x65, 0x1d, 0x0b, 0x01, 0x00, 0x63, 0x22, 0x0b, 0x01, 0x00, 0x6f, 0x17,
+    0x06, 0x02, 0x01, 0x68, 0x27, 0x0b, 0x72, 0x2c, 0x0b, 0x01, 0x00, 0x69, 0xf9, 0x07, 0x01, 0x00,
+    0x6f, 0x31, 0x0b, 0x01, 0x00, 0x65, 0x36, 0x0b, 0x01, 0x00, 0x69, 0x3b, 0x0b, 0x01, 0x00, 0x74,
+    0x75, 0x03, 0x01, 0x00, 0x64, 0x40, 0x0b, 0x02, 0x01, 0x6e, 0x07, 0x07, 0x76, 0x42, 0x06, 0x01,
+    0x00, 0x65, 0x45, 0x0b, 0x01, 0x00, 0x68, 0x4a, 0x0b, 0x01, 0x00, 0x61, 0x07, 0x07, 0x01, 0x00,
+    0x65, 0x4f, 0x0b, 0x81, 0x00, 0x61, 0x54, 0x0b, 0x01, 0x00, 0x6e, 0x59, 0x0b, 0x01, 0x00, 0x6e,
+    0x5e, 0x0b, 0x01, 0x00, 0x64, 0xc5, 0x05, 0x01, 0x00, 0x69, 0x63, 0x0b, 0x01, 0x00, 0x63, 0x68,
+    0x0b, 0x02, 0x00, 0x65, 0x75, 0x03, 0x69, 0x6d, 0x0b, 0x02, 0x00, 0x69, 0x72, 0x0b, 0x75, 0x77,
+    0x0b, 0x02, 0x00, 0x73, 0x1c, 0x09, 0x74, 0x07, 0x07, 0x01, 0x00, 0x74, 0x7c, 0x0b, 0x01, 0x00,
+    0x65, 0x81, 0x0b, 0x01, 0x00, 0x69, 0xee, 0x08, 0x01, 0x00, 0x74, 0x86, 0x0b, 0x01, 0x00, 0x69,
+    0x8b, 0x0b, 0x01, 0x00, 0x61, 0x22, 0x0b, 0x01, 0x00, 0x74, 0x90, 0x0b, 0x01, 0x00, 0x65, 0x4c,
+    0x04, 0x01, 0x00, 0x62, 0xe8, 0x05, 0x01, 0x00, 0x69, 0x13, 0x07, 0x01, 0x00, 0x62, 0xbc, 0x07,
+    0x01, 0x00, 0x72, 0x95, 0x0b, 0x01, 0x00, 0x6b, 0x42, 0x06, 0x01, 0x00, 0x73, 0x42, 0x06, 0x01,
+    0x00, 0x74, 0x9d, 0x0b, 0x01, 0x00, 0x6f, 0x13, 0x07, 0x01, 0x00, 0x6e, 0x13, 0x07, 0x01, 0x00,
+    0x69, 0x68, 0x06, 0x02, 0x01, 0x63, 0xa2, 0x0b, 0x73, 0xa7, 0x0b, 0x02, 0x00, 0x63, 0xac, 0x0b,
+    0x68, 0xb1, 0x0b, 0x01, 0x00, 0x68, 0xb6, 0x0b, 0x01, 0x00, 0x62, 0xbb, 0x0b, 0x02, 0x01, 0x61,
+    0x9d, 0x05, 0x69, 0x3e, 0x07, 0x02, 0x01, 0x63, 0xc0, 0x0b, 0x64, 0xc5, 0x0b, 0x01, 0x00, 0x75,
+    0xca, 0x0b, 0x01, 0x00, 0x6f, 0xcf, 0x0b, 0x01, 0x00, 0x75, 0xd4, 0x0b, 0x03, 0x01, 0x6f, 0xd9,
+    0x0b, 0x74, 0xde, 0x0b, 0x75, 0x53, 0x05, 0x01, 0x00, 0x76, 0x07, 0x07, 0x01, 0x00, 0x65, 0x70,
+    0x05, 0x02, 0x01, 0x75, 0xe3, 0x0b, 0x77, 0xc5, 0x05, 0x01, 0x00, 0x74, 0xe8, 0x0b, 0x01, 0x00,
+    0x74, 0xed, 0x0b, 0x01, 0x00, 0x75, 0xf2, 0x0b, 0x01, 0x00, 0x76, 0xf7, 0x0b, 0x01, 0x00, 0x65,
+    0xfc, 0x0b, 0x02, 0x00, 0x72, 0x04, 0x0c, 0x77, 0x09, 0x0c, 0x01, 0x00, 0x72, 0x0e, 0x0c, 0x01,
+    0x00, 0x77, 0x07, 0x07, 0x02, 0x00, 0x6c, 0x75, 0x03, 0x74, 0x90, 0x0b, 0x01, 0x00, 0x65, 0x6b,
+    0x07, 0x01, 0x00, 0x61, 0x13, 0x0c, 0x02, 0x00, 0x6e, 0x18, 0x0c, 0x72, 0x1d, 0x0c, 0x01, 0x00,
+    0x70, 0x22, 0x0c, 0x01, 0x00, 0x6f, 0x27, 0x0c, 0x01, 0x00, 0x6c, 0x2c, 0x0c, 0x01, 0x00, 0x65,
+    0xf2, 0x0a, 0x01, 0x00, 0x67, 0x70, 0x05, 0x01, 0x00, 0x69, 0x31, 0x0c, 0x01, 0x00, 0x70, 0x36,
+    0x0c, 0x02, 0x00, 0x6d, 0x3b, 0x0c, 0x72, 0x1c, 0x02, 0x01, 0x00, 0x75, 0x40, 0x0c, 0x02, 0x00,
+    0x65, 0x45, 0x0c, 0x6f, 0x4d, 0x0c, 0x01, 0x00, 0x6e, 0x52, 0x0c, 0x01, 0x00, 0x63, 0x57, 0x0c,
+    0x03, 0x01, 0x63, 0x5c, 0x0c, 0x66, 0x61, 0x0c, 0x6e, 0x66, 0x0c, 0x02, 0x01, 0x62, 0x6b, 0x0c,
+    0x6e, 0x07, 0x07, 0x01, 0x00, 0x62, 0x70, 0x0c, 0x01, 0x00, 0x66, 0x75, 0x0c, 0x01, 0x00, 0x69,
+    0x57, 0x07, 0x01, 0x00, 0x61, 0x59, 0x03, 0x01, 0x00, 0x69, 0x7a, 0x0c, 0x01, 0x00, 0x74, 0x7f,
+    0x0c, 0x02, 0x01, 0x69, 0x84, 0x0c, 0x75, 0x3e, 0x07, 0x01, 0x00, 0x73, 0x89, 0x0c, 0x01, 0x00,
+    0x63, 0x70, 0x05, 0x01, 0x00, 0x64, 0x8e, 0x0c, 0x01, 0x00, 0x6b, 0x93, 0x0c, 0x01, 0x00, 0x75,
+    0x07, 0x07, 0x02, 0x01, 0x6f, 0x6a, 0x04, 0x76, 0xe5, 0x02, 0x01, 0x00, 0x73, 0x98, 0x0c, 0x01,
+    0x00, 0x72, 0x5e, 0x06, 0x01, 0x00, 0x75, 0x75, 0x03, 0x01, 0x00, 0x72, 0x9d, 0x0c, 0x01, 0x00,
+    0x70, 0xa2, 0x0c, 0x01, 0x00, 0x72, 0xaa, 0x0c, 0x02, 0x01, 0x6d, 0xaf, 0x0c, 0x74, 0xb4, 0x0c,
+    0x01, 0x00, 0x6f, 0xb9, 0x0c, 0x01, 0x00, 0x6e, 0x6b, 0x07, 0x01, 0x00, 0x76, 0x3e, 0x07, 0x01,
+    0x00, 0x64, 0x42, 0x06, 0x01, 0x00, 0x74, 0xc1, 0x0c, 0x01, 0x00, 0x72, 0xe5, 0x02, 0x01, 0x00,
+    0x64, 0xc6, 0x0c, 0x01, 0x00, 0x66, 0x42, 0x06, 0x01, 0x00, 0x75, 0xcb, 0x0c, 0x01, 0x00, 0x69,
+    0x12, 0x06, 0x01, 0x00, 0x6e, 0xf9, 0x07, 0x01, 0x00, 0x67, 0xe5, 0x02, 0x01, 0x00, 0x6c, 0xd0,
+    0x0c, 0x01, 0x00, 0x6b, 0xd5, 0x0c, 0x01, 0x00, 0x75, 0x66, 0x08, 0x01, 0x00, 0x72, 0xda, 0x0c,
+    0x01, 0x00, 0x62, 0x09, 0x0b, 0x01, 0x00, 0x64, 0xe2, 0x0c, 0x02, 0x00, 0x61, 0xe7, 0x0c, 0x6f,
+    0xec, 0x0c, 0x02, 0x00, 0x69, 0xcf, 0x09, 0x6c, 0xf1, 0x0c, 0x03, 0x00, 0x61, 0xf6, 0x0c, 0x69,
+    0xfe, 0x0c, 0x72, 0x03, 0x0d, 0x01, 0x00, 0x73, 0xe5, 0x02, 0x01, 0x00, 0x73, 0x08, 0x0d, 0x01,
+    0x00, 0x6d, 0x3e, 0x07, 0x01, 0x00, 0x65, 0x27, 0x0b, 0x01, 0x00, 0x76, 0x0d, 0x0d, 0x01, 0x00,
+    0x72, 0x39, 0x08, 0x01, 0x00, 0x65, 0x12, 0x0d, 0x01, 0x00, 0x69, 0x17, 0x0d, 0x01, 0x00, 0x6f,
+    0x1c, 0x0d, 0x01, 0x00, 0x63, 0x13, 0x07, 0x01, 0x00, 0x72, 0x21, 0x0d, 0x01, 0x00, 0x6c, 0x26,
+    0x0d, 0x01, 0x00, 0x61, 0x2b, 0x0d, 0x01, 0x00, 0x72, 0x30, 0x0d, 0x01, 0x00, 0x7a, 0x70, 0x0c,
+    0x01, 0x00, 0x67, 0x35, 0x0d, 0x01, 0x00, 0x6e, 0x3a, 0x0d, 0x01, 0x00, 0x62, 0x3f, 0x0d, 0x01,
+    0x00, 0x6d, 0x44, 0x0d, 0x02, 0x00, 0x63, 0x13, 0x07, 0x64, 0x49, 0x0d, 0x01, 0x00, 0x6f, 0x4e,
+    0x0d, 0x01, 0x00, 0x72, 0x84, 0x08, 0x01, 0x00, 0x75, 0x35, 0x0d, 0x01, 0x00, 0x68, 0xe8, 0x05,
+    0x01, 0x00, 0x65, 0x53, 0x0d, 0x01, 0x00, 0x6e, 0x5b, 0x0d, 0x02, 0x00, 0x69, 0xa8, 0x07, 0x73,
+    0x07, 0x07, 0x01, 0x00, 0x6f, 0x60, 0x0d, 0x02, 0x00, 0x69, 0xa8, 0x07, 0x77, 0x38, 0x06, 0x01,
+    0x00, 0x6f, 0x65, 0x0d, 0x01, 0x00, 0x63, 0x6a, 0x0d, 0x81, 0xff, 0x69, 0xa8, 0x07, 0x01, 0x00,
+    0x72, 0x1c, 0x09, 0x01, 0x00, 0x67, 0x07, 0x07, 0x01, 0x00, 0x74, 0x6f, 0x0d, 0x01, 0x00, 0x64,
+    0x74, 0x0d, 0x01, 0x00, 0x74, 0x79, 0x0d, 0x01, 0x00, 0x65, 0x75, 0x03, 0x01, 0x00, 0x65, 0x7e,
+    0x0d, 0x01, 0x00, 0x72, 0x83, 0x0d, 0x01, 0x00, 0x72, 0x88, 0x0d, 0x01, 0x00, 0x65, 0x90, 0x0d,
+    0x81, 0x00, 0x69, 0xa8, 0x07, 0x01, 0x00, 0x6c, 0x95, 0x0d, 0x01, 0x00, 0x74, 0xe2, 0x0c, 0x81,
+    0xff, 0x75, 0xe3, 0x0b, 0x01, 0x00, 0x6c, 0x9a, 0x0d, 0x01, 0x00, 0x65, 0x9f, 0x0d, 0x01, 0x00,
+    0x74, 0xa4, 0x0d, 0x01, 0x00, 0x75, 0x5e, 0x06, 0x01, 0x00, 0x75, 0x27, 0x07, 0x01, 0x00, 0x74,
+    0xc6, 0x0c, 0x01, 0x00, 0x6d, 0x63, 0x0b, 0x01, 0x00, 0x74, 0x27, 0x0b, 0x01, 0x00, 0x75, 0x09,
+    0x0a, 0x81, 0x00, 0x72, 0x92, 0x09, 0x01, 0x00, 0x69, 0xa9, 0x0d, 0x01, 0x00, 0x67, 0xae, 0x0d,
+    0x01, 0x00, 0x68, 0xb3, 0x0d, 0x02, 0x00, 0x63, 0xbb, 0x0d, 0x68, 0xc0, 0x0d, 0x01, 0x00, 0x65,
+    0xc5, 0x0d, 0x01, 0x00, 0x65, 0xff, 0x09, 0x01, 0x00, 0x73, 0x7c, 0x0b, 0x01, 0x00, 0x65, 0xca,
+    0x0d, 0x01, 0x00, 0x69, 0xd2, 0x0d, 0x81, 0x00, 0x62, 0xd7, 0x0d, 0x01, 0x00, 0x65, 0xdc, 0x0d,
+    0x01, 0x00, 0x68, 0x42, 0x06, 0x01, 0x00, 0x62, 0xd7, 0x0d, 0x01, 0x00, 0x63, 0xe5, 0x02, 0x01,
+    0x00, 0x72, 0xe1, 0x0d, 0x01, 0x00, 0x65, 0xe6, 0x0d, 0x01, 0x00, 0x6c, 0xeb, 0x0d, 0x01, 0x00,
+    0x72, 0xf0, 0x0d, 0x01, 0x00, 0x70, 0x07, 0x07, 0x01, 0x00, 0x74, 0xf5, 0x0d, 0x01, 0x00, 0x6f,
+    0x9d, 0x05, 0x01, 0x00, 0x65, 0x2b, 0x0d, 0x01, 0x00, 0x69, 0xca, 0x0b, 0x02, 0x01, 0x6e, 0x07,
+    0x07, 0x72, 0xe5, 0x02, 0x01, 0x00, 0x74, 0xfa, 0x0d, 0x01, 0x00, 0x65, 0x9e, 0x07, 0x01, 0x00,
+    0x72, 0xf9, 0x07, 0x01, 0x00, 0x77, 0xff, 0x0d, 0x01, 0x00, 0x64, 0x04, 0x0e, 0x01, 0x00, 0x74,
+    0x09, 0x0e, 0x01, 0x00, 0x62, 0x5e, 0x03, 0x01, 0x00, 0x62, 0xe5, 0x02, 0x01, 0x00, 0x77, 0x38,
+    0x06, 0x81, 0xff, 0x77, 0xc5, 0x05, 0x01, 0x00, 0x65, 0x0e, 0x0e, 0x01, 0x00, 0x69, 0x13, 0x0e,
+    0x01, 0x00, 0x73, 0x18, 0x0e, 0x02, 0x00, 0x65, 0x07, 0x07, 0x73, 0x1d, 0x0e, 0x01, 0x00, 0x74,
+    0x22, 0x0e, 0x01, 0x00, 0x64, 0x27, 0x0e, 0x01, 0x00, 0x68, 0x2c, 0x0e, 0x01, 0x00, 0x6b, 0x07,
+    0x07, 0x01, 0x00, 0x66, 0x31, 0x0e, 0x01, 0x00, 0x73, 0x36, 0x0e, 0x01, 0x00, 0x75, 0x3e, 0x0e,
+    0x01, 0x00, 0x6c, 0xe5, 0x02, 0x01, 0x00, 0x6f, 0xcf, 0x09, 0x01, 0x00, 0x61, 0x83, 0x09, 0x01,
+    0x00, 0x6f, 0x43, 0x0e, 0x01, 0x00, 0x62, 0x48, 0x0e, 0x01, 0x00, 0x6b, 0x4d, 0x0e, 0x81, 0xff,
+    0x73, 0x52, 0x0e, 0x01, 0x00, 0x65, 0xe5, 0x02, 0x01, 0x00, 0x6f, 0x27, 0x07, 0x01, 0x00, 0x61,
+    0x57, 0x0e, 0x02, 0x00, 0x61, 0xca, 0x0b, 0x65, 0x1c, 0x09, 0x01, 0x00, 0x6e, 0x92, 0x09, 0x01,
+    0x00, 0x65, 0x72, 0x06, 0x01, 0x00, 0x75, 0x5c, 0x0e, 0x02, 0x00, 0x61, 0x61, 0x0e, 0x76, 0x1c,
+    0x09, 0x01, 0x00, 0x72, 0xd7, 0x0d, 0x01, 0x00, 0x61, 0x27, 0x07, 0x01, 0x00, 0x72, 0x66, 0x0e,
+    0x01, 0x00, 0x69, 0xe5, 0x02, 0x01, 0x00, 0x6c, 0x6b, 0x0e, 0x82, 0x01, 0x61, 0x2b, 0x0d, 0x65,
+    0x6b, 0x07, 0x81, 0xff, 0x73, 0x07, 0x07, 0x01, 0x00, 0x6e, 0xe6, 0x04, 0x01, 0x00, 0x6e, 0x70,
+    0x0e, 0x01, 0x00, 0x69, 0x92, 0x0a, 0x02, 0x00, 0x63, 0x13, 0x07, 0x6d, 0x3b, 0x0c, 0x01, 0x00,
+    0x6e, 0x75, 0x0e, 0x01, 0x00, 0x6f, 0x7a, 0x0e, 0x81, 0xff, 0x77, 0x38, 0x06, 0x01, 0x00, 0x65,
+    0x27, 0x07, 0x01, 0x00, 0x6e, 0x94, 0x07, 0x01, 0x00, 0x6e, 0xae, 0x0d, 0x01, 0x00, 0x69, 0x89,
+    0x08, 0x01, 0x00, 0x65, 0x68, 0x06, 0x01, 0x00, 0x61, 0x7f, 0x0e, 0x01, 0x00, 0x6e, 0xca, 0x0b,
+    0x01, 0x00, 0x74, 0x09, 0x0b, 0x01, 0x00, 0x65, 0x84, 0x0e, 0x01, 0x00, 0x65, 0xe2, 0x0c, 0x01,
+    0x00, 0x6c, 0x89, 0x0e, 0x01, 0x00, 0x61, 0x8e, 0x0e, 0x01, 0x00, 0x69, 0x59, 0x03, 0x01, 0x00,
+    0x77, 0x42, 0x06, 0x02, 0x01, 0x72, 0x07, 0x07, 0x73, 0x93, 0x0e, 0x01, 0x00, 0x64, 0x98, 0x0e,
+    0x01, 0x00, 0x66, 0x66, 0x07, 0x01, 0x00, 0x70, 0x9d, 0x0e, 0x01, 0x00, 0x6f, 0xa2, 0x0e, 0x81,
+    0x00, 0x69, 0xa7, 0x0e, 0x01, 0x00, 0x69, 0xac, 0x0e, 0x01, 0x00, 0x69, 0xb1, 0x0e, 0x01, 0x00,
+    0x61, 0x65, 0x0a, 0x01, 0x00, 0x6d, 0xae, 0x0d, 0x02, 0x00, 0x63, 0xb6, 0x0e, 0x73, 0xbb, 0x0e,
+    0x01, 0x00, 0x74, 0x13, 0x07, 0x81, 0xff, 0x6c, 0x42, 0x06, 0x81, 0x00, 0x69, 0xc0, 0x0e, 0x01,
+    0x00, 0x74, 0xc5, 0x0e, 0x01, 0x00, 0x61, 0xcd, 0x0e, 0x01, 0x00, 0x63, 0x3e, 0x07, 0x01, 0x00,
+    0x61, 0x68, 0x06, 0x82, 0xff, 0x65, 0xbb, 0x0d, 0x77, 0xd2, 0x0e, 0x01, 0x00, 0x61, 0xf7, 0x02,
+    0x01, 0x00, 0x65, 0xd7, 0x0e, 0x01, 0x00, 0x72, 0x6a, 0x04, 0x02, 0x00, 0x64, 0x7c, 0x0b, 0x65,
+    0xe2, 0x07, 0x01, 0x00, 0x62, 0xdc, 0x0e, 0x01, 0x00, 0x61, 0xe1, 0x0e, 0x01, 0x00, 0x63, 0x07,
+    0x07, 0x01, 0x00, 0x74, 0xe6, 0x0e, 0x01, 0x00, 0x73, 0x30, 0x0d, 0x01, 0x00, 0x75, 0x68, 0x06,
+    0x01, 0x00, 0x69, 0xeb, 0x0e, 0x01, 0x00, 0x65, 0x0e, 0x0b, 0x81, 0xff, 0x65, 0x6a, 0x04, 0x01,
+    0x00, 0x6b, 0x09, 0x0b, 0x81, 0x00, 0x61, 0x3d, 0x06, 0x81, 0x00, 0x75, 0xe3, 0x0b, 0x01, 0x00,
+    0x72, 0xf0, 0x0e, 0x01, 0x00, 0x6e, 0xf5, 0x0e, 0x01, 0x00, 0x61, 0xf5, 0x09, 0x01, 0x00, 0x68,
+    0xfa, 0x0e, 0x01, 0x00, 0x74, 0x70, 0x0c, 0x01, 0x00, 0x65, 0xff, 0x0e, 0x01, 0x00, 0x64, 0x04,
+    0x0f, 0x01, 0x00, 0x69, 0xdc, 0x0d, 0x02, 0x00, 0x69, 0x68, 0x06, 0x70, 0x09, 0x0f, 0x01, 0x00,
+    0x6c, 0xf2, 0x0b, 0x01, 0x00, 0x72, 0x0e, 0x0f, 0x01, 0x00, 0x69, 0x13, 0x0f, 0x01, 0x00, 0x65,
+    0xe6, 0x04, 0x01, 0x00, 0x68, 0x18, 0x0f, 0x01, 0x00, 0x66, 0x13, 0x07, 0x01, 0x00, 0x64, 0xe5,
+    0x02, 0x01, 0x00, 0x63, 0xa6, 0x04, 0x01, 0x00, 0x65, 0x1d, 0x0f, 0x01, 0x00, 0x69, 0xf7, 0x02,
+    0x01, 0x00, 0x65, 0x89, 0x08, 0x01, 0x00, 0x75, 0xe5, 0x02, 0x01, 0x00, 0x6c, 0x22, 0x0f, 0x01,
+    0x00, 0x63, 0x1c, 0x09, 0x01, 0x00, 0x6e, 0x27, 0x0f, 0x01, 0x00, 0x69, 0x2c, 0x0f, 0x01, 0x00,
+    0x74, 0x31, 0x0f, 0x01, 0x00, 0x6c, 0x36, 0x0f, 0x81, 0xff, 0x73, 0x3b, 0x0f, 0x01, 0x00, 0x61,
+    0x40, 0x0f, 0x01, 0x00, 0x70, 0x72, 0x06, 0x01, 0x00, 0x66, 0xdb, 0x06, 0x01, 0x00, 0x61, 0x45,
+    0x0f, 0x01, 0x00, 0x76, 0xe5, 0x02, 0x01, 0x00, 0x65, 0x4a, 0x0f, 0x01, 0x00, 0x65, 0x4f, 0x0f,
+    0x01, 0x00, 0x7a, 0xe8, 0x05, 0x02, 0x00, 0x69, 0xdc, 0x0d, 0x6f, 0x75, 0x03, 0x01, 0x00, 0x69,
+    0x54, 0x0f, 0x01, 0x00, 0x65, 0xf7, 0x02, 0x01, 0x00, 0x61, 0x6b, 0x07, 0x01, 0x00, 0x69, 0x59,
+    0x0f, 0x01, 0x00, 0x63, 0x5c, 0x0c, 0x81, 0xff, 0x65, 0x6b, 0x07, 0x01, 0x00, 0x63, 0x59, 0x0f,
+    0x01, 0x00, 0x61, 0x39, 0x08, 0x01, 0x00, 0x61, 0x59, 0x0f, 0x01, 0x00, 0x6f, 0x5e, 0x0f, 0x01,
+    0x00, 0x72, 0x63, 0x0f, 0x01, 0x00, 0x6f, 0x68, 0x0f, 0x01, 0x00, 0x6f, 0x6d, 0x0f, 0x81, 0x00,
+    0x73, 0x07, 0x07, 0x01, 0x00, 0x6c, 0x72, 0x0f, 0x01, 0x00, 0x65, 0x5e, 0x03, 0x01, 0x00, 0x74,
+    0xee, 0x08, 0x01, 0x00, 0x6c, 0x77, 0x0f, 0x01, 0x00, 0x63, 0xe6, 0x04, 0x01, 0x00, 0x73, 0x7c,
+    0x0f, 0x01, 0x00, 0x65, 0x81, 0x0f, 0x01, 0x00, 0x6f, 0x86, 0x0f, 0x01, 0x00, 0x70, 0x18, 0x05,
+    0x01, 0x00, 0x73, 0x8b, 0x0f, 0x01, 0x00, 0x74, 0x90, 0x0f, 0x01, 0x00, 0x70, 0x13, 0x07, 0x01,
+    0x00, 0x63, 0x68, 0x06, 0x01, 0x00, 0x6e, 0x09, 0x0b, 0x01, 0x00, 0x74, 0x1c, 0x09, 0x01, 0x00,
+    0x6c, 0x6b, 0x07, 0x01, 0x00, 0x73, 0x95, 0x0f, 0x01, 0x00, 0x77, 0x6a, 0x04, 0x01, 0x00, 0x6e,
+    0x9a, 0x0f, 0x01, 0x00, 0x69, 0x9f, 0x0f, 0x01, 0x00, 0x65, 0xa4, 0x0f, 0x01, 0x00, 0x68, 0x1c,
+    0x09, 0x81, 0xff, 0x64, 0x07, 0x07, 0x01, 0x00, 0x70, 0xe5, 0x02, 0x01, 0x00, 0x63, 0xac, 0x0f,
+    0x01, 0x00, 0x65, 0xb1, 0x0f, 0x01, 0x00, 0x74, 0x75, 0x0c, 0x01, 0x00, 0x64, 0xe8, 0x05, 0x01,
+    0x00, 0x74, 0xe6, 0x04, 0x02, 0x01, 0x64, 0x07, 0x07, 0x72, 0x07, 0x07, 0x01, 0x00, 0x61, 0xb6,
+    0x0f, 0x81, 0x00, 0x6c, 0xe6, 0x04, 0x01, 0x00, 0x6c, 0x75, 0x03,
+};
+
+#endif // DICTIONARY_DATA_H
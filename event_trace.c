@@ -0,0 +1,322 @@
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "SEGGER_RTT.h"
+
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_default_backends.h"
+
+#include "common.h"
+
+#define EVENT_TRACE_SIZE                    256           // records kept, the oldest are lost once it is full (8 bytes each)
+#define EVENT_RTT_CHANNEL                   2             // RTT up channel the events are dumped on (1 is the press trace)
+#define EVENT_RTT_BUFFER_SIZE               256
+#define EVENT_DUMP_CHUNK                    64            // most bytes written to RTT each poll cycle
+#define EVENT_DUMP_TIMEOUT                  100           // poll cycles without the RTT buffer being read before a dump is given up
+#define EVENT_CLOCK_FREQ                    (APP_TIMER_CLOCK_FREQ / (APP_TIMER_CONFIG_RTC_FREQUENCY + 1))
+#define EVENT_CLOCK_BITS                    24            // width of the RTC counter, the times wrap
+#define EVENT_LOG_FORMAT_MODE               true          // also pass the log messages recorded to the logger from the idle loop
+
+/*
+ * Event trace, each stage a key passes through on its way to the host (button press and release
+ * accepted, code processed, report sent, taken by the SoftDevice, notification sent) is recorded
+ * with the RTC counter so a dump shows where the time goes (host/_build/events). The probes are
+ * EVENT_PROBE() in common.h, with EVENT_TRACE_MODE false they and the buffer are compiled out.
+ *
+ * The RTC is used rather than the CPU cycle counter as the cycle counter stops while the CPU
+ * sleeps between stages. The probes are in the timer and SoftDevice event handlers, which don't run
+ * in interrupts: APP_TIMER_CONFIG_USE_SCHEDULER and NRF_SDH_DISPATCH_MODEL (1, the scheduler) in
+ * sdk_config.h put their events on the scheduler, and app_sched_execute() runs them from the main
+ * loop, as it does event_log_process(). event_record() isn't reentrant and relies on this, so a
+ * probe must not be put in an interrupt handler (e.g. the SAADC callback in battery.c) without
+ * holding interrupts off around it. event_log_process() still copies each record in a critical
+ * region, which keeps the copy whole if that ever changes but doesn't make event_record() safe.
+ *
+ * Dump format, all values low byte first:
+ * [1] header of EVENT_TRACE_HEADER_SIZE bytes: 'M', 'E', EVENT_TRACE_VERSION, width of the
+ *     counter in bits, counter frequency in Hz (4 bytes) and the number of records (2 bytes)
+ * [2] EVENT_RECORD_SIZE bytes for each record, oldest first: RTC counter (4 bytes), enum
+ *     trace_event, then its two arguments (1 and 2 bytes)
+ *
+ * The events are dumped on their own RTT channel by the trace device command, along with the press
+ * trace, e.g. JLinkRTTLogger -Device NRF52832_XXAA -If SWD -Speed 4000 -RTTChannel 2 session.events
+ *
+ * Log messages on the hot path are events too (EVENT_LOG()), a message number and a value rather
+ * than a formatted line, so the timer handlers don't wait on the logger. They are formatted from
+ * log_formats by the host tool, and passed to the logger from the idle loop with
+ * event_log_process(), where the deferred logger formats them as it does any other line.
+ */
+
+typedef struct
+{
+	uint32_t time;               // RTC counter
+	uint8_t event;               // enum trace_event
+	uint8_t arg8;
+	uint16_t arg16;
+} event_record_t;
+
+STATIC_ASSERT(sizeof(event_record_t) == EVENT_RECORD_SIZE);
+
+// Format of each log message
+typedef struct
+{
+	char const * p_format;
+	bool pair;                   // the value holds two values, see EVENT_LOG_PAIR()
+} log_format_t;
+
+static const log_format_t log_formats[] =
+{
+	[LOG_PRESS_TOO_SHORT]       = { "Press Rejected: too short (%d)", false },
+	[LOG_PRESS_SHORTER]         = { "Press Rejected: shorter than usual (%d)", false },
+	[LOG_PRESS_SUSPECT]         = { "Press Rejected: short suspect press (%d, gap %d)", true },
+	[LOG_ALT_KEY_MODE]          = { "ALT KEY MODE", false },
+	[LOG_HOLD_TRIGGERED]        = { "HOLD TRIGGERED", false },
+	[LOG_CODE_RESET]            = { "CODE RESET", false },
+	[LOG_SEND_KEY]              = { "Send Key: %d / %d", true },
+	[LOG_SPECULATIVE_CORRECTED] = { "Speculative Key Corrected", false },
+	[LOG_CODE_CORRECTED]        = { "Key Code Corrected: -> %d", false },
+	[LOG_UNKNOWN_CODE]          = { "Unknown Key Code Entered: %d", false },
+	[LOG_UNKNOWN_COMMAND]       = { "Unknown Command Code Entered: %d", false },
+	[LOG_SEND_MACRO]            = { "Send Macro: %d keys", false },
+	[LOG_MODIFIERS]             = { "MODIFIERS: %d / %d", true },
+	[LOG_NUMERIC_LAYER]         = { "NUMERIC LAYER: %d", false },
+	[LOG_COMPLETE_WORD]         = { "Complete Word: %d keys", false },
+	[LOG_EXPAND_ABBREVIATION]   = { "Expand Abbreviation: %d keys", false },
+	[LOG_CALCULATOR]            = { "CALCULATOR: %d", false },
+	[LOG_CALCULATOR_RESULT]     = { "Calculator Result: %d keys", false },
+	[LOG_COMPOSE]               = { "COMPOSE: %d", false },
+	[LOG_COMPOSE_LINE_FULL]     = { "Compose Line Full", false },
+	[LOG_SEND_LINE]             = { "Send Line: %d keys", false },
+	[LOG_ABBREVIATIONS]         = { "ABBREVIATIONS: %d", false },
+	[LOG_COMMAND]               = { "COMMAND", false },
+	[LOG_SPECULATIVE]           = { "SPECULATIVE: %d", false },
+	[LOG_BATTERY_LEVEL]         = { "SENDING BATTERY LEVEL: %d", false },
+	[LOG_CALCULATOR_ERROR]      = { "Calculator error at %d", false },
+	[LOG_PAIR]                  = { "Pair with a new device", false },
+	[LOG_NEXT_PEER]             = { "Switch to peer %d", false },
+	[LOG_POWER_PROFILE]         = { "Power profile %d: %d", true },
+	[LOG_REPORT_QUEUE_FULL]     = { "Report queue full, %d keys lost", false },
+	[LOG_AUTO_SPACE]            = { "AUTO SPACE: %d", false },
+};
+
+// Events recorded, a ring that overwrites the oldest record
+static event_record_t event_buffer[EVENT_TRACE_MODE ? EVENT_TRACE_SIZE : 1];
+static uint16_t event_rp = 0;
+static uint16_t event_count = 0;
+static uint32_t event_total = 0;                 // records made since start up, the last event_count are kept
+static uint32_t log_next = 0;                    // record event_log_process() looks at next (counted as event_total)
+
+static uint8_t rtt_buffer[EVENT_TRACE_MODE ? EVENT_RTT_BUFFER_SIZE : 1];
+static bool dumping = false;                     // recording stops while the events are dumped
+static uint16_t dump_offset = 0;
+static uint8_t dump_stalled = 0;                 // poll cycles since the last part of the dump was written
+
+
+// Function for starting a new event trace
+void event_trace_init(void)
+{
+	event_rp = 0;
+	event_count = 0;
+	dumping = false;
+
+	if (EVENT_TRACE_MODE)
+	{
+		UNUSED_RETURN_VALUE(SEGGER_RTT_ConfigUpBuffer(EVENT_RTT_CHANNEL, "Events", rtt_buffer, sizeof(rtt_buffer),
+													  SEGGER_RTT_MODE_NO_BLOCK_SKIP));
+	}
+}
+
+
+/**@brief Function for recording an event, called through EVENT_PROBE().
+ *
+ * @param[in]   event   Stage reached.
+ * @param[in]   arg8    First argument, as given for the event in enum trace_event.
+ * @param[in]   arg16   Second argument.
+ */
+void event_record(enum trace_event event, uint8_t arg8, uint16_t arg16)
+{
+	event_record_t * p_record;
+
+	if (dumping)
+	{
+		return;
+	}
+
+	if (event_count == EVENT_TRACE_SIZE)
+	{
+		event_rp = (event_rp + 1) % EVENT_TRACE_SIZE;
+		event_count--;
+	}
+	p_record = &event_buffer[(event_rp + event_count++) % EVENT_TRACE_SIZE];
+	p_record->time = app_timer_cnt_get();
+	p_record->event = event;
+	p_record->arg8 = arg8;
+	p_record->arg16 = arg16;
+	event_total++;
+}
+
+
+/**@brief Function for finding how a log message is formatted.
+ *
+ * @param[in]   message    enum log_message.
+ * @param[in]   value      Value recorded with it.
+ * @param[out]  pp_format  printf format, taking two int values.
+ * @param[out]  p_values   The two values, the second is 0 for a message with one.
+ *
+ * @return      false if the message is unknown (a dump from a later version).
+ */
+bool event_log_format(uint8_t message, uint16_t value, char const ** pp_format, uint16_t * p_values)
+{
+	if ((message >= ARRAY_SIZE(log_formats)) || (log_formats[message].p_format == NULL))
+	{
+		return false;
+	}
+	*pp_format = log_formats[message].p_format;
+	p_values[0] = log_formats[message].pair ? (value >> 8) : value;
+	p_values[1] = log_formats[message].pair ? (value & 0xFF) : 0;
+	return true;
+}
+
+
+/**@brief Function for passing the next log message recorded to the logger, called from the idle loop.
+ *
+ * @details Messages overwritten in the ring before they are reached are skipped.
+ *
+ * @return      true if a message was passed, there may be more.
+ */
+bool event_log_process(void)
+{
+	event_record_t record;
+	char const * p_format;
+	uint16_t values[2];
+
+	if (!EVENT_TRACE_MODE || !EVENT_LOG_FORMAT_MODE)
+	{
+		return false;
+	}
+
+	for (;;)
+	{
+		// each record is copied with interrupts held off, see the reentrancy note at the top
+		bool found = false;
+		CRITICAL_REGION_ENTER();
+		log_next = MAX(log_next, event_total - event_count);
+		if (log_next < event_total)
+		{
+			record = event_buffer[(event_rp + (log_next - (event_total - event_count))) % EVENT_TRACE_SIZE];
+			log_next++;
+			found = true;
+		}
+		CRITICAL_REGION_EXIT();
+
+		if (!found)
+		{
+			return false;
+		}
+		if ((record.event == EVENT_LOG) && event_log_format(record.arg8, record.arg16, &p_format, values))
+		{
+			NRF_LOG_INFO(p_format, values[0], values[1]);
+			return true;
+		}
+	}
+}
+
+
+// size of the dump with its header (in bytes)
+uint16_t event_trace_size(void)
+{
+	return EVENT_TRACE_HEADER_SIZE + (event_count * EVENT_RECORD_SIZE);
+}
+
+
+/**@brief Function for reading part of the event dump.
+ *
+ * @param[in]   offset   Position in the dump, from the start of the header.
+ * @param[out]  p_data   Buffer for the bytes read.
+ * @param[in]   len      Most bytes to read.
+ *
+ * @return      Number of bytes read, 0 at the end of the dump.
+ */
+uint16_t event_trace_read(uint16_t offset, uint8_t * p_data, uint16_t len)
+{
+	uint8_t header[EVENT_TRACE_HEADER_SIZE] =
+	{
+		'M', 'E', EVENT_TRACE_VERSION, EVENT_CLOCK_BITS,
+		EVENT_CLOCK_FREQ & 0xFF, (EVENT_CLOCK_FREQ >> 8) & 0xFF, (EVENT_CLOCK_FREQ >> 16) & 0xFF, EVENT_CLOCK_FREQ >> 24,
+		event_count & 0xFF, event_count >> 8
+	};
+	uint16_t count = 0;
+
+	for (; (count < len) && (offset < event_trace_size()); count++, offset++)
+	{
+		if (offset < EVENT_TRACE_HEADER_SIZE)
+		{
+			p_data[count] = header[offset];
+		}
+		else
+		{
+			uint16_t index = (offset - EVENT_TRACE_HEADER_SIZE) / EVENT_RECORD_SIZE;
+			event_record_t const * p_record = &event_buffer[(event_rp + index) % EVENT_TRACE_SIZE];
+			uint8_t record[EVENT_RECORD_SIZE] =
+			{
+				p_record->time & 0xFF, (p_record->time >> 8) & 0xFF, (p_record->time >> 16) & 0xFF, p_record->time >> 24,
+				p_record->event, p_record->arg8, p_record->arg16 & 0xFF, p_record->arg16 >> 8
+			};
+			p_data[count] = record[(offset - EVENT_TRACE_HEADER_SIZE) % EVENT_RECORD_SIZE];
+		}
+	}
+	return count;
+}
+
+
+// start writing the events to RTT, recording stops until they have all been written
+void event_trace_dump_start(void)
+{
+	if (!EVENT_TRACE_MODE)
+	{
+		return;
+	}
+	NRF_LOG_INFO("Event Dump: %d records", event_count);
+	dumping = true;
+	dump_offset = 0;
+	dump_stalled = 0;
+}
+
+
+// write the next part of a dump, called every poll cycle
+void event_trace_poll(void)
+{
+	uint8_t chunk[EVENT_DUMP_CHUNK];
+	uint16_t len;
+
+	if (!dumping)
+	{
+		return;
+	}
+
+	len = event_trace_read(dump_offset, chunk, sizeof(chunk));
+	if (len == 0)
+	{
+		// a new trace starts once the dump is written
+		NRF_LOG_INFO("Event Dump: done");
+		event_trace_init();
+		return;
+	}
+
+	// as the press trace, skip rather than wait when the RTT buffer is full and give up if
+	// nothing is reading it
+	if (SEGGER_RTT_Write(EVENT_RTT_CHANNEL, chunk, len) == len)
+	{
+		dump_offset += len;
+		dump_stalled = 0;
+	}
+	else if (++dump_stalled >= EVENT_DUMP_TIMEOUT)
+	{
+		NRF_LOG_WARNING("Event Dump: not read");
+		dumping = false;
+	}
+}
@@ -0,0 +1,657 @@
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "nrf_assert.h"
+#include "app_error.h"
+#include "ble_err.h"
+#include "ble_hids.h"
+
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_default_backends.h"
+
+#include "common.h"
+#include "hid_reports.h"
+
+/*
+ * Keyboard input reports, sent as notifications of the HID service set up in bluetooth.c. Key
+ * patterns that can't be sent straight away (no transmit buffers in the SoftDevice) are queued and
+ * sent as earlier notifications complete. Keys wait in a backlog until there is room in the queue,
+ * so a burst longer than the queue (a macro, a calculator result or a composed line) is fed to it
+ * as notifications complete rather than losing the keys that don't fit.
+ *
+ * The SoftDevice is only reached through ble_hids_inp_rep_send() and ble_hids_boot_kb_inp_rep_send(),
+ * so the send path can also be run on a host against a fake one (see host/).
+ */
+
+// Record the log messages of the send path as events, formatted in the idle loop or on a host (see event_trace.c)
+#define HID_REPORTS_LOG_MODE                true
+
+// Number of elements that can be enqueued, longer bursts wait in the backlog
+#define MAX_BUFFER_ENTRIES                  32                                         
+
+// Number of keys that can wait for room in the queue, enough for the longest burst
+#define BACKLOG_SIZE                        SEND_KEYS_MAX
+
+// How a key in the backlog is sent
+#define BACKLOG_PACKED                      0x01          // pressed together with the packed keys next to it
+#define BACKLOG_HOLD                        0x02          // left pressed for the host to repeat
+#define BACKLOG_RELEASE                     0x04          // no key, release the keys left pressed
+
+// Position of the modifier byte in the Input Report. 
+#define MODIFIER_KEY_POS                    0                                          
+// The start position of the key scan code in a HID Report. 
+#define SCAN_CODE_POS                       2                                          
+// Key code indicating the press of the Shift Key. 
+#define SHIFT_KEY_CODE                      0x02                                       
+
+// Maximum number of key presses that can be sent in one Input Report. 
+#define MAX_KEYS_IN_ONE_REPORT              (INPUT_REPORT_KEYS_MAX_LEN - SCAN_CODE_POS)
+
+
+/**Buffer queue access macros
+ *
+ * @{ */
+/** Initialization of buffer list */
+#define BUFFER_LIST_INIT()     \
+    do                         \
+    {                          \
+        buffer_list.rp    = 0; \
+        buffer_list.wp    = 0; \
+        buffer_list.count = 0; \
+    } while (0)
+
+/** Provide status of data list is full or not */
+#define BUFFER_LIST_FULL() \
+    ((MAX_BUFFER_ENTRIES == buffer_list.count) ? true : false)
+
+/** Provides status of buffer list is empty or not */
+#define BUFFER_LIST_EMPTY() \
+    ((0 == buffer_list.count) ? true : false)
+
+#define BUFFER_ELEMENT_INIT(i)                 \
+    do                                         \
+    {                                          \
+        buffer_list.buffer[(i)].data_len = 0;  \
+    } while (0)
+
+
+// Abstracts buffer element
+typedef struct hid_key_buffer
+{
+    uint8_t      data_offset;                     // Max Data that can be buffered for all entries
+    uint8_t      data_len;                        // Total length of data
+    uint8_t      modifier;                        // Modifier keys the key pattern is sent with
+    bool         hold;                            // Leave the keys pressed after the pattern is sent
+    uint8_t      data[MAX_KEYS_IN_ONE_REPORT];    // Scanned key pattern, copied as the caller's buffer may not outlive the entry
+    ble_hids_t * p_instance;                      // Identifies peer and service instance
+} buffer_entry_t;
+
+STATIC_ASSERT(sizeof(buffer_entry_t) % 4 == 0);
+
+// Circular buffer list
+typedef struct
+{
+    buffer_entry_t buffer[MAX_BUFFER_ENTRIES]; // Maximum number of entries that can enqueued in the list
+    uint8_t        rp;                         // Index to the read location
+    uint8_t        wp;                         // Index to write location
+    uint8_t        count;                      // Number of elements in the list
+} buffer_list_t;
+
+STATIC_ASSERT(sizeof(buffer_list_t) % 4 == 0);
+
+// Key waiting in the backlog
+typedef struct
+{
+    uint8_t modifier;
+    uint8_t key;
+    uint8_t flags;                                // BACKLOG_*
+} backlog_key_t;
+
+// HID service the reports are sent with.
+static ble_hids_t *      mp_hids        = NULL;
+// Current protocol mode.
+static bool              m_in_boot_mode = false;                    
+// Handle of the current connection.
+static uint16_t          m_conn_handle  = BLE_CONN_HANDLE_INVALID;  
+// List to enqueue not just data to be sent, but also related information like the handle, connection handle etc
+static buffer_list_t     buffer_list;                               
+// Modifier keys sent with the current key pattern.
+static uint8_t           modifier_keys = 0;
+// Most entries that have been waiting in the buffer list.
+static uint8_t           buffer_high_water = 0;
+// Key patterns that were lost as the buffer list or the backlog was full.
+static uint32_t          buffer_dropped_count = 0;
+// Keys waiting for room in the buffer list, in the order they were sent.
+static backlog_key_t     backlog[BACKLOG_SIZE];
+static uint8_t           backlog_rp = 0;
+static uint8_t           backlog_count = 0;
+
+
+/**@brief   Function for transmitting a key scan Press & Release Notification.
+ *
+ * @warning This handler is an example only. You need to analyze how you wish to send the key
+ *          release.
+ *
+ * @param[in]  p_instance     Identifies the service for which Key Notifications are requested.
+ * @param[in]  p_key_pattern  Pointer to key pattern.
+ * @param[in]  pattern_len    Length of key pattern. 0 < pattern_len < 7.
+ * @param[in]  pattern_offset Offset applied to Key Pattern for transmission.
+ * @param[in]  hold           Leave the last key pressed, the final release notification is not sent.
+ * @param[out] actual_len     Provides actual length of Key Pattern transmitted, making buffering of
+ *                            rest possible if needed.
+ * @return     NRF_SUCCESS on success, NRF_ERROR_RESOURCES in case transmission could not be
+ *             completed due to lack of transmission buffer or other error codes indicating reason
+ *             for failure.
+ *
+ * @note       In case of NRF_ERROR_RESOURCES, remaining pattern that could not be transmitted
+ *             can be enqueued \ref buffer_enqueue function.
+ *             In case a pattern of 'cofFEe' is the p_key_pattern, with pattern_len as 6 and
+ *             pattern_offset as 0, the notifications as observed on the peer side would be
+ *             1>    'c', 'o', 'f', 'F', 'E', 'e'
+ *             2>    -  , 'o', 'f', 'F', 'E', 'e'
+ *             3>    -  ,   -, 'f', 'F', 'E', 'e'
+ *             4>    -  ,   -,   -, 'F', 'E', 'e'
+ *             5>    -  ,   -,   -,   -, 'E', 'e'
+ *             6>    -  ,   -,   -,   -,   -, 'e'
+ *             7>    -  ,   -,   -,   -,   -,  -
+ *             Here, '-' refers to release, 'c' refers to the key character being transmitted.
+ *             Therefore 7 notifications will be sent.
+ *             In case an offset of 4 was provided, the pattern notifications sent will be from 5-7
+ *             will be transmitted.
+ */
+static uint32_t send_key_scan_press_release(ble_hids_t * p_hids,
+                                            uint8_t    * p_key_pattern,
+                                            uint16_t     pattern_len,
+                                            uint16_t     pattern_offset,
+                                            bool         hold,
+                                            uint16_t   * p_actual_len)
+{
+    ret_code_t err_code;
+    uint16_t offset;
+    uint16_t data_len;
+    uint8_t  data[INPUT_REPORT_KEYS_MAX_LEN];
+
+    // HID Report Descriptor enumerates an array of size 6, the pattern hence shall not be any
+    // longer than this.
+    STATIC_ASSERT((INPUT_REPORT_KEYS_MAX_LEN - 2) == 6);
+
+    ASSERT(pattern_len <= (INPUT_REPORT_KEYS_MAX_LEN - 2));
+
+    offset   = pattern_offset;
+    data_len = pattern_len;
+
+    if (hold && (offset >= data_len))
+    {
+        *p_actual_len = offset;
+        return NRF_SUCCESS;
+    }
+
+    do
+    {
+        // Reset the data buffer.
+        memset(data, 0, sizeof(data));
+
+        // Copy the scan code.
+        memcpy(data + SCAN_CODE_POS + offset, p_key_pattern + offset, data_len - offset);
+
+        data[MODIFIER_KEY_POS] = modifier_keys;
+
+        if (!m_in_boot_mode)
+        {
+            err_code = ble_hids_inp_rep_send(p_hids,
+                                             INPUT_REPORT_KEYS_INDEX,
+                                             INPUT_REPORT_KEYS_MAX_LEN,
+                                             data,
+                                             m_conn_handle);
+        }
+        else
+        {
+            err_code = ble_hids_boot_kb_inp_rep_send(p_hids,
+                                                     INPUT_REPORT_KEYS_MAX_LEN,
+                                                     data,
+                                                     m_conn_handle);
+        }
+
+        if (err_code != NRF_SUCCESS)
+        {
+            break;
+        }
+
+        offset++;
+    }
+    while ((offset < data_len) || ((offset == data_len) && !hold));
+
+    *p_actual_len = offset;
+
+    return err_code;
+}
+
+
+/**@brief   Function for initializing the buffer queue used to key events that could not be
+ *          transmitted
+ *
+ * @warning This handler is an example only. You need to analyze how you wish to buffer or buffer at
+ *          all.
+ *
+ * @note    In case of HID keyboard, a temporary buffering could be employed to handle scenarios
+ *          where encryption is not yet enabled or there was a momentary link loss or there were no
+ *          Transmit buffers.
+ */
+static void buffer_init(void)
+{
+    uint32_t buffer_count;
+
+    BUFFER_LIST_INIT();
+
+    for (buffer_count = 0; buffer_count < MAX_BUFFER_ENTRIES; buffer_count++)
+    {
+        BUFFER_ELEMENT_INIT(buffer_count);
+    }
+}
+
+
+/**@brief Function for enqueuing key scan patterns that could not be transmitted either completely
+ *        or partially.
+ *
+ * @warning This handler is an example only. You need to analyze how you wish to send the key
+ *          release.
+ *
+ * @param[in]  p_hids         Identifies the service for which Key Notifications are buffered.
+ * @param[in]  p_key_pattern  Pointer to key pattern.
+ * @param[in]  pattern_len    Length of key pattern.
+ * @param[in]  offset         Offset applied to Key Pattern when requesting a transmission on
+ *                            dequeue, @ref buffer_dequeue.
+ * @param[in]  hold           Leave the keys pressed after the pattern is sent.
+ * @return     NRF_SUCCESS on success, else an error code indicating reason for failure.
+ */
+static uint32_t buffer_enqueue(ble_hids_t * p_hids,
+                               uint8_t    * p_key_pattern,
+                               uint16_t     pattern_len,
+                               uint16_t     offset,
+                               bool         hold)
+{
+    buffer_entry_t * element;
+    uint32_t         err_code = NRF_SUCCESS;
+
+    if (BUFFER_LIST_FULL())
+    {
+        // Element cannot be buffered.
+        err_code = NRF_ERROR_NO_MEM;
+        buffer_dropped_count++;
+        EVENT_PROBE(EVENT_DROP, EVENT_DROP_QUEUE_FULL, pattern_len);
+        EVENT_LOG(HID_REPORTS_LOG_MODE, LOG_REPORT_QUEUE_FULL, pattern_len);
+    }
+    else
+    {
+        // Make entry of buffer element and copy data.
+        element              = &buffer_list.buffer[(buffer_list.wp)];
+        element->p_instance  = p_hids;
+        element->data_offset = offset;
+        element->data_len    = pattern_len;
+        element->modifier    = modifier_keys;
+        element->hold        = hold;
+        memcpy(element->data, p_key_pattern, pattern_len);
+
+        buffer_list.count++;
+        buffer_list.wp++;
+        buffer_high_water = MAX(buffer_high_water, buffer_list.count);
+
+        if (buffer_list.wp == MAX_BUFFER_ENTRIES)
+        {
+            buffer_list.wp = 0;
+        }
+    }
+
+    return err_code;
+}
+
+
+/**@brief   Function to dequeue key scan patterns that could not be transmitted either completely of
+ *          partially.
+ *
+ * @warning This handler is an example only. You need to analyze how you wish to send the key
+ *          release.
+ *
+ * @param[in]  tx_flag   Indicative of whether the dequeue should result in transmission or not.
+ * @note       A typical example when all keys are dequeued with transmission is when link is
+ *             disconnected.
+ *
+ * @return     NRF_SUCCESS on success, else an error code indicating reason for failure.
+ */
+static uint32_t buffer_dequeue(bool tx_flag)
+{
+    buffer_entry_t * p_element;
+    uint32_t         err_code = NRF_SUCCESS;
+    uint16_t         actual_len;
+
+    if (BUFFER_LIST_EMPTY())
+    {
+        err_code = NRF_ERROR_NOT_FOUND;
+    }
+    else
+    {
+        bool remove_element = true;
+
+        p_element = &buffer_list.buffer[(buffer_list.rp)];
+
+        if (tx_flag)
+        {
+            modifier_keys = p_element->modifier;
+            err_code = send_key_scan_press_release(p_element->p_instance,
+                                                   p_element->data,
+                                                   p_element->data_len,
+                                                   p_element->data_offset,
+                                                   p_element->hold,
+                                                   &actual_len);
+            // An additional notification is needed for release of all keys, therefore check
+            // is for actual_len <= element->data_len and not actual_len < element->data_len
+            if (((err_code == NRF_ERROR_RESOURCES) || (err_code == NRF_ERROR_BUSY)) &&
+                (actual_len <= p_element->data_len))
+            {
+                // Transmission could not be completed, do not remove the entry, adjust next data to
+                // be transmitted
+                p_element->data_offset = actual_len;
+                remove_element         = false;
+            }
+        }
+
+        if (remove_element)
+        {
+            if (tx_flag)
+            {
+                EVENT_PROBE(EVENT_ACCEPT, p_element->data[0], buffer_list.count - 1);
+            }
+            else
+            {
+                EVENT_PROBE(EVENT_DROP, EVENT_DROP_DISCONNECTED, p_element->data_len);
+            }
+            BUFFER_ELEMENT_INIT(buffer_list.rp);
+
+            buffer_list.rp++;
+            buffer_list.count--;
+
+            if (buffer_list.rp == MAX_BUFFER_ENTRIES)
+            {
+                buffer_list.rp = 0;
+            }
+        }
+    }
+
+    return err_code;
+}
+
+
+// send as many of the queued key patterns as the SoftDevice will take
+static void buffer_drain(void)
+{
+    while (buffer_dequeue(true) == NRF_SUCCESS)
+    {
+        // Keep sending until the queue is empty or the SoftDevice is out of buffers.
+    }
+}
+
+
+/**@brief Function for sending sample key presses to the peer.
+ *
+ * @param[in]   key_pattern_len   Pattern length.
+ * @param[in]   p_key_pattern     Pattern to be sent.
+ * @param[in]   hold              Leave the keys pressed after the pattern is sent.
+ */
+static void keys_send(uint8_t key_pattern_len, uint8_t * p_key_pattern, bool hold)
+{
+    ret_code_t err_code;
+    uint16_t actual_len;
+
+    EVENT_PROBE(EVENT_SEND, p_key_pattern[0], key_pattern_len);
+
+    if (!BUFFER_LIST_EMPTY())
+    {
+        // Earlier keys are still waiting to be sent, queue behind them so that bursts such as a
+        // correction (backspace then key) keep their order. The queue is also retried, as a send
+        // refused with nothing in flight has no TX complete to restart it.
+        UNUSED_VARIABLE(buffer_enqueue(mp_hids, p_key_pattern, key_pattern_len, 0, hold));
+        buffer_drain();
+        return;
+    }
+
+    err_code = send_key_scan_press_release(mp_hids,
+                                           p_key_pattern,
+                                           key_pattern_len,
+                                           0,
+                                           hold,
+                                           &actual_len);
+    // An additional notification is needed for release of all keys, therefore check
+    // is for actual_len <= key_pattern_len and not actual_len < key_pattern_len.
+    if (((err_code == NRF_ERROR_RESOURCES) || (err_code == NRF_ERROR_BUSY)) &&
+        (actual_len <= key_pattern_len))
+    {
+        // Buffer enqueue routine return value is not intentionally checked.
+        // Rationale: Its better to have a a few keys missing than have a system
+        // reset. Recommendation is to work out most optimal value for
+        // MAX_BUFFER_ENTRIES to minimize chances of buffer queue full condition
+        UNUSED_VARIABLE(buffer_enqueue(mp_hids, p_key_pattern, key_pattern_len, actual_len, hold));
+    }
+    else if (err_code == NRF_SUCCESS)
+    {
+        EVENT_PROBE(EVENT_ACCEPT, p_key_pattern[0], 0);
+    }
+    else
+    {
+        EVENT_PROBE(EVENT_DROP, EVENT_DROP_REFUSED, key_pattern_len);
+    }
+
+
+    if ((err_code != NRF_SUCCESS) &&
+        (err_code != NRF_ERROR_INVALID_STATE) &&
+        (err_code != NRF_ERROR_RESOURCES) &&
+        (err_code != NRF_ERROR_BUSY) &&
+        (err_code != BLE_ERROR_GATTS_SYS_ATTR_MISSING)
+       )
+    {
+        APP_ERROR_HANDLER(err_code);
+    }
+}
+
+// add a key to the end of the backlog
+static void backlog_add(uint8_t key, uint8_t modifiers, uint8_t flags)
+{
+	if (backlog_count == BACKLOG_SIZE)
+	{
+		buffer_dropped_count++;
+		EVENT_PROBE(EVENT_DROP, EVENT_DROP_BACKLOG, 1);
+		return;
+	}
+
+	backlog_key_t * p_key = &backlog[(backlog_rp + backlog_count) % BACKLOG_SIZE];
+	p_key->modifier = modifiers;
+	p_key->key = key;
+	p_key->flags = flags;
+	backlog_count++;
+}
+
+
+// remove the key at the start of the backlog
+static backlog_key_t backlog_take(void)
+{
+	backlog_key_t key = backlog[backlog_rp];
+
+	backlog_rp = (backlog_rp + 1) % BACKLOG_SIZE;
+	backlog_count--;
+	return key;
+}
+
+
+/**@brief Function for sending the keys in the backlog while there is room in the buffer list.
+ *
+ * @details Runs of up to MAX_KEYS_IN_ONE_REPORT different packed keys with the same modifiers are
+ *          sent as one key pattern, pressed together and released one at a time in order.
+ */
+static void backlog_send(void)
+{
+	uint8_t pattern[MAX_KEYS_IN_ONE_REPORT] = {0};
+
+	while ((backlog_count > 0) && !BUFFER_LIST_FULL())
+	{
+		backlog_key_t first = backlog_take();
+		uint8_t pattern_len = 0;
+
+		modifier_keys = first.modifier;
+		if (first.flags & BACKLOG_RELEASE)
+		{
+			keys_send(0, pattern, false);
+			continue;
+		}
+
+		pattern[pattern_len++] = first.key;
+		// a key can only be in a pattern once
+		while ((first.flags & BACKLOG_PACKED) && (backlog_count > 0) && (pattern_len < MAX_KEYS_IN_ONE_REPORT))
+		{
+			backlog_key_t const * p_next = &backlog[backlog_rp];
+			if (!(p_next->flags & BACKLOG_PACKED) || (p_next->modifier != first.modifier) ||
+				(memchr(pattern, p_next->key, pattern_len) != NULL))
+			{
+				break;
+			}
+			pattern[pattern_len++] = backlog_take().key;
+		}
+		keys_send(pattern_len, pattern, (first.flags & BACKLOG_HOLD) != 0);
+	}
+}
+
+
+// throw away the keys in the backlog
+static void backlog_clear(void)
+{
+	if (backlog_count > 0)
+	{
+		EVENT_PROBE(EVENT_DROP, EVENT_DROP_BACKLOG, backlog_count);
+		backlog_count = 0;
+	}
+}
+
+
+void send_key(uint8_t key, uint8_t modifiers)
+{
+	backlog_add(key, modifiers, 0);
+	backlog_send();
+}
+
+
+/**@brief Function for sending a string of keys, each pressed and released in turn.
+ *
+ * @details All of the reports are queued together so they go out as a single burst, the keys that
+ *          don't fit in the queue are sent from the backlog as earlier reports complete.
+ *
+ * @param[in]   p_keys   Modifier byte and key code for each key.
+ * @param[in]   count    Number of keys, up to SEND_KEYS_MAX.
+ */
+void send_keys(uint8_t const * p_keys, uint8_t count)
+{
+	for (uint8_t i = 0; i < count; i++)
+	{
+		backlog_add(p_keys[(i * 2) + 1], p_keys[i * 2], 0);
+	}
+	backlog_send();
+}
+
+
+/**@brief Function for sending a string of keys in as few reports as possible.
+ *
+ * @details Runs of up to MAX_KEYS_IN_ONE_REPORT different keys with the same modifiers are sent as
+ *          one key pattern, pressed together and released one at a time in order, so n keys take
+ *          n + 1 reports instead of 2n.
+ *
+ * @param[in]   p_keys   Modifier byte and key code for each key.
+ * @param[in]   count    Number of keys, up to SEND_KEYS_MAX.
+ */
+void send_keys_packed(uint8_t const * p_keys, uint8_t count)
+{
+	for (uint8_t i = 0; i < count; i++)
+	{
+		backlog_add(p_keys[(i * 2) + 1], p_keys[i * 2], BACKLOG_PACKED);
+	}
+	backlog_send();
+}
+
+
+// press a key and leave it pressed, so that the host repeats it until send_key_release() is called
+void send_key_hold(uint8_t key, uint8_t modifiers)
+{
+	backlog_add(key, modifiers, BACKLOG_HOLD);
+	backlog_send();
+}
+
+
+// release any keys left pressed by send_key_hold()
+void send_key_release(void)
+{
+	backlog_add(0, 0, BACKLOG_RELEASE);
+	backlog_send();
+}
+
+
+// Function for initializing the report queue, the reports are sent with the HID service given
+void hid_reports_init(ble_hids_t * p_hids)
+{
+	mp_hids = p_hids;
+	buffer_init();
+}
+
+
+void hid_reports_connected(uint16_t conn_handle)
+{
+	m_conn_handle = conn_handle;
+}
+
+
+// throw away the reports still queued, they can't be sent once the link is lost and left in the
+// queue they would hold back every key sent after reconnecting
+void hid_reports_disconnected(void)
+{
+	m_conn_handle = BLE_CONN_HANDLE_INVALID;
+	while (buffer_dequeue(false) == NRF_SUCCESS)
+	{
+	}
+	backlog_clear();
+}
+
+
+// send queued reports now that notifications have been sent, a TX complete event can free more
+// than one buffer, then refill the queue from the backlog
+void hid_reports_tx_complete(void)
+{
+	buffer_drain();
+	backlog_send();
+}
+
+
+// retry the queue, called with the button poll as a send refused while nothing was in flight won't
+// be followed by a TX complete
+void hid_reports_poll(void)
+{
+	if (!BUFFER_LIST_EMPTY() && (m_conn_handle != BLE_CONN_HANDLE_INVALID))
+	{
+		buffer_drain();
+		backlog_send();
+	}
+}
+
+
+void hid_reports_boot_mode(bool boot_mode)
+{
+	m_in_boot_mode = boot_mode;
+}
+
+
+uint8_t hid_reports_queue_high_water(void)
+{
+	return buffer_high_water;
+}
+
+
+uint32_t hid_reports_dropped_count(void)
+{
+	return buffer_dropped_count;
+}
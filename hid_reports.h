@@ -0,0 +1,27 @@
+#ifndef HID_REPORTS_H
+#define HID_REPORTS_H
+
+#include "ble_hids.h"
+
+// Index of Input Report. 
+#define INPUT_REPORT_KEYS_INDEX             0
+// Maximum length of the Input Report characteristic. 
+#define INPUT_REPORT_KEYS_MAX_LEN           8
+
+void hid_reports_init(ble_hids_t * p_hids);
+
+void hid_reports_connected(uint16_t conn_handle);
+
+void hid_reports_disconnected(void);
+
+void hid_reports_tx_complete(void);
+
+void hid_reports_poll(void);
+
+void hid_reports_boot_mode(bool boot_mode);
+
+uint8_t hid_reports_queue_high_water(void);
+
+uint32_t hid_reports_dropped_count(void);
+
+#endif //HID_REPORTS_H
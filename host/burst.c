@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "nordic_common.h"
+
+#include "common.h"
+#include "sim.h"
+#include "fake_softdevice.h"
+#include "hid_reports.h"
+
+/*
+ * Burst stress benchmark for the report path. Random bursts of keys, like those from macros,
+ * replayed compose lines and key repeat, are sent with send_key(), send_keys() and
+ * send_keys_packed() straight into hid_reports.c on the fake SoftDevice, which refuses sends at
+ * random, delays TX complete events and drops the link in the middle of bursts.
+ *
+ * The keys reaching the host are matched against the keys sent (longest common subsequence), keys
+ * sent but not matched were dropped and keys that arrived but weren't matched were corrupted.
+ *
+ * The random bursts are followed by the largest burst each source of bursts in the firmware can
+ * send, one after another.
+ *
+ * usage: burst [-n bursts] [-s seed]
+ */
+
+#define BURST_MAX_KEYS            24            // most keys in one random burst
+#define BURST_LARGEST_COUNT       10            // largest bursts sent for each source
+#define BURST_SETTLE_TIME         1000          // least time given to each burst to reach the host (in ms)
+#define BURST_KEY_TIME            50            // time given to each key of a burst to reach the host (in ms)
+#define BURST_DISCONNECT_EVERY    8             // bursts between link drops, in scenarios with them
+#define BURST_DISCONNECT_TIME     100           // time the link is down for (in ms)
+#define BURST_MAX_SENT            SIM_MAX_REPORTS
+
+static const char burst_chars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,";
+
+typedef struct
+{
+	fake_sd_config_t link;
+	bool disconnects;             // drop the link part way through some bursts
+} burst_scenario_t;
+
+// Link of the standard configuration (15 ms, one notification queued) with each kind of fault
+static const burst_scenario_t scenarios[] =
+{
+	{ { "clean",           15000, 6, 1, 3,  0, 0,     0 }, false },
+	{ { "resources 20%",   15000, 6, 1, 3, 20, 0,     0 }, false },
+	{ { "busy 5%",         15000, 6, 1, 3,  0, 5,     0 }, false },
+	{ { "tx complete 20ms", 15000, 6, 1, 3,  0, 0, 20000 }, false },
+	{ { "disconnects",     15000, 6, 1, 3,  0, 0,     0 }, true },
+	{ { "all",             15000, 6, 1, 3, 20, 5, 20000 }, true },
+	{ { "all queue 4",     15000, 6, 4, 3, 20, 5, 20000 }, true },
+};
+
+// how a burst is sent
+enum burst_method { BURST_KEYS, BURST_PACKED, BURST_SINGLE };
+
+// Largest bursts from each source in the firmware
+typedef struct
+{
+	char const * p_name;
+	uint8_t count;                // keys in the burst
+	enum burst_method method;
+	bool repeats;                 // every key the same, so no two keys can share a packed pattern
+} burst_source_t;
+
+static const burst_source_t sources[] =
+{
+	{ "abbreviation",  41, BURST_KEYS,   false },   // backspaces for a full word, an expansion and the key ending the word
+	{ "calculator",    CALCULATOR_MAX_RESULT, BURST_KEYS, false },
+	{ "compose line",  COMPOSE_MAX_LINE, BURST_PACKED, false },
+	{ "compose repeats", COMPOSE_MAX_LINE, BURST_PACKED, true },
+	{ "macro",         SEND_KEYS_MAX, BURST_KEYS, false },   // the longest macro the macro storage holds
+};
+
+static uint32_t burst_count = 200;
+static uint32_t seed = 1;
+
+// Keys sent, modifier byte and key code
+static uint16_t sent[BURST_MAX_SENT];
+static uint32_t sent_count = 0;
+
+
+static uint16_t report_value(uint8_t modifiers, uint8_t key)
+{
+	return (uint16_t)((modifiers << 8) | key);
+}
+
+
+// length of the longest common subsequence of the keys sent and the keys the host received
+static uint32_t keys_matched(void)
+{
+	static uint16_t row[2][SIM_MAX_REPORTS + 1];
+	uint32_t received = MIN(sim.report_count, SIM_MAX_REPORTS);
+
+	memset(row, 0, sizeof(row));
+	for (uint32_t i = 1; i <= sent_count; i++)
+	{
+		uint16_t * p_row = row[i & 1];
+		uint16_t const * p_last = row[(i - 1) & 1];
+
+		for (uint32_t j = 1; j <= received; j++)
+		{
+			sim_report_t const * p_report = &sim.reports[j - 1];
+			if (sent[i - 1] == report_value(p_report->modifiers, p_report->key))
+			{
+				p_row[j] = p_last[j - 1] + 1;
+			}
+			else
+			{
+				p_row[j] = MAX(p_last[j], p_row[j - 1]);
+			}
+		}
+	}
+	return row[sent_count & 1][received];
+}
+
+
+// send one burst of random keys, each random burst uses the next of the three ways of sending
+// keys, returns the number of keys sent
+static uint8_t burst_send(uint32_t burst, burst_source_t const * p_source)
+{
+	uint8_t keys[SEND_KEYS_MAX * 2];
+	uint8_t count = (p_source != NULL) ? p_source->count : 1 + (rand() % BURST_MAX_KEYS);
+	enum burst_method method = (p_source != NULL) ? p_source->method : (enum burst_method)(burst % 3);
+	char c = burst_chars[rand() % (sizeof(burst_chars) - 1)];
+
+	count = MIN(count, BURST_MAX_SENT - sent_count);
+	for (uint8_t i = 0; i < count; i++)
+	{
+		if ((p_source == NULL) || !p_source->repeats)
+		{
+			c = burst_chars[rand() % (sizeof(burst_chars) - 1)];
+		}
+		UNUSED_VARIABLE(sim_char_key(c, &keys[(i * 2) + 1], &keys[i * 2]));
+		sent[sent_count++] = report_value(keys[i * 2], keys[(i * 2) + 1]);
+	}
+
+	switch (method)
+	{
+	    case BURST_KEYS:
+			send_keys(keys, count);
+			break;
+	    case BURST_PACKED:
+			send_keys_packed(keys, count);
+			break;
+	    default:
+			for (uint8_t i = 0; i < count; i++)
+			{
+				send_key(keys[(i * 2) + 1], keys[i * 2]);
+			}
+			break;
+	}
+	return count;
+}
+
+
+// send the random bursts, or the largest bursts of a source, over a link
+static void run_scenario(burst_scenario_t const * p_scenario, burst_source_t const * p_source)
+{
+	uint32_t bursts = (p_source != NULL) ? BURST_LARGEST_COUNT : burst_count;
+	uint64_t busy_time = 0;
+	uint32_t matched;
+	uint32_t received;
+
+	fake_sd_config = p_scenario->link;
+	fake_sd_seed(seed);
+	srand(seed);
+	sim_init(false);
+	sim_set_connected(true);
+
+	for (uint32_t burst = 0; (burst < bursts) && (sent_count < BURST_MAX_SENT); burst++)
+	{
+		uint32_t start = sim.time;
+		uint32_t first_report = sim.report_count;
+
+		uint8_t count = burst_send(burst, p_source);
+
+		if (p_scenario->disconnects && ((burst % BURST_DISCONNECT_EVERY) == (BURST_DISCONNECT_EVERY - 1)))
+		{
+			// drop the link before the SoftDevice has had time to send the burst
+			sim_advance(rand() % ((p_scenario->link.interval_us * 3) / 1000));
+			sim_set_connected(false);
+			sim_advance(BURST_DISCONNECT_TIME);
+			sim_set_connected(true);
+		}
+		sim_advance_to(start + MAX(BURST_SETTLE_TIME, count * BURST_KEY_TIME));
+
+		// the burst is sending from the call until the last of its keys arrives
+		if ((sim.report_count > first_report) && (sim.report_count <= SIM_MAX_REPORTS))
+		{
+			busy_time += sim.reports[sim.report_count - 1].time - start;
+		}
+	}
+
+	received = MIN(sim.report_count, SIM_MAX_REPORTS);
+	matched = keys_matched();
+
+	printf("%-18s %-16s %6u %6u %6u %6u %8.1f %8.2f %6u %6u %6u %6u\n", fake_sd_config.p_name,
+		   (p_source != NULL) ? p_source->p_name : "random", sent_count, matched,
+		   sent_count - matched, received - matched, (busy_time > 0) ? (matched * 1000.0) / busy_time : 0.0,
+		   (double)fake_sd_stats.notifications / MAX(matched, 1), fake_sd_stats.queue_high_water,
+		   hid_reports_queue_high_water(), hid_reports_dropped_count(), fake_sd_stats.lost);
+}
+
+
+int main(int argc, char * argv[])
+{
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:s:")) != -1)
+	{
+		switch (opt)
+		{
+		    case 'n':
+				burst_count = strtoul(optarg, NULL, 10);
+				break;
+		    case 's':
+				seed = strtoul(optarg, NULL, 10);
+				break;
+		    default:
+				fprintf(stderr, "usage: burst [-n bursts] [-s seed]\n");
+				return 2;
+		}
+	}
+
+	printf("%u bursts of 1 to %u keys and %u of the largest from each source, seed %u\n", burst_count,
+		   BURST_MAX_KEYS, BURST_LARGEST_COUNT, seed);
+	printf("%-18s %-16s %6s %6s %6s %6s %8s %8s %6s %6s %6s %6s\n", "scenario", "bursts", "sent", "keys", "drop",
+		   "wrong", "chars/s", "reports", "sdq", "queue", "full", "lost");
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(scenarios); i++)
+	{
+		for (int32_t j = -1; j < (int32_t)ARRAY_SIZE(sources); j++)
+		{
+			int status;
+			pid_t pid;
+
+			// each run starts from a fresh report queue in its own process
+			fflush(stdout);
+			pid = fork();
+			if (pid == 0)
+			{
+				run_scenario(&scenarios[i], (j >= 0) ? &sources[j] : NULL);
+				fflush(stdout);
+				_exit(0);
+			}
+			waitpid(pid, &status, 0);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,540 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <getopt.h>
+
+#include "nordic_common.h"
+
+#include "sim.h"
+
+#include "codes.h"
+
+/*
+ * Typing cost benchmark. Scores the code tables in codes.h against a text: every character is
+ * typed the cheapest way the keyboard allows, from key_table or alt_key_table, with the shift
+ * alt code (or shift lock for a run of capitals) for capitals and shifted keys that have no code
+ * of their own, and through the numeric layer where switching to it pays off. Capitals at the
+ * start of a sentence and the space after punctuation that ends a word cost nothing, as the
+ * keyboard adds them.
+ *
+ * A code takes its elements (and a chord of both buttons first for an alt code), then the normal
+ * gap if no longer code starts with it (CODE_LEAF), otherwise the advance time for the decoder to
+ * end it. The times are upper bounds on speed, an operator that never hesitates or makes mistakes.
+ *
+ * usage: cost [-c] [-f text-file] [-t press,gap]...
+ *
+ *   -c    also print the cost of each character
+ *   -f    text to score (default a set of ATC instructions)
+ *   -t    operator press and gap times in ms, can be given more than once (default slow, standard
+ *         and fast operators)
+ */
+
+#define COST_MAX_SPEEDS           8
+#define COST_CHAR_COUNT           128
+#define COST_WORD_LEN             5             // characters in a word, for words per minute
+
+static const char default_text[] =
+	"Speedbird 215, climb FL310, cleared direct LAM, squawk 4721.\n"
+	"Easyjet 42 descend to 3000 ft QNH 1013, reduce speed 210 kt.\n"
+	"Ryanair 7AB contact London 128.05, good day.\n"
+	"Shamrock 12 turn left heading 270, vectors ILS runway 27L.\n"
+	"N123AB cleared to land runway 09R, wind 240/12, caution wake turbulence.\n"
+	"KLM 1004 hold at OCK FL140, expect further clearance 1435z.\n";
+
+// Operator speed (in ms)
+typedef struct
+{
+	char const * p_name;
+	uint32_t press;               // how long each element is pressed for
+	uint32_t gap;                 // time between presses
+} cost_speed_t;
+
+static const cost_speed_t standard_speeds[] =
+{
+	{ "slow",     120, 120 },
+	{ "standard",  80,  80 },
+	{ "fast",      60,  60 },
+};
+
+// Cost of typing part of the text
+typedef struct
+{
+	uint32_t chars;               // characters typed, including those the keyboard adds
+	uint32_t actions;             // presses, a chord of both buttons counts as one
+	uint32_t chords;
+	uint32_t elements;
+	uint32_t timeouts;            // codes ended by the advance time rather than sent on release
+	uint32_t shifts;              // shift alt codes typed
+	uint32_t switches;            // numeric layer switches
+	uint64_t wait;                // time codes waited to be ended after their last release (in ms)
+	uint64_t time;                // (in ms)
+} cost_t;
+
+// States the keyboard can be in between characters
+enum cost_state
+{
+	STATE_STANDARD,
+	STATE_LOCKED,                 // shift locked
+	STATE_NUMERIC,                // numeric layer on
+	STATE_COUNT
+};
+
+#define COST_NONE                 UINT64_MAX    // time of a character that can't be typed
+
+static cost_speed_t speeds[COST_MAX_SPEEDS];
+static uint8_t speed_count = 0;
+static uint32_t advance_ms;
+static bool per_char = false;
+
+
+static void add(cost_t * p_total, cost_t const * p_cost)
+{
+	p_total->chars += p_cost->chars;
+	p_total->actions += p_cost->actions;
+	p_total->chords += p_cost->chords;
+	p_total->elements += p_cost->elements;
+	p_total->timeouts += p_cost->timeouts;
+	p_total->shifts += p_cost->shifts;
+	p_total->switches += p_cost->switches;
+	p_total->wait += p_cost->wait;
+	p_total->time = (p_total->time == COST_NONE) || (p_cost->time == COST_NONE) ? COST_NONE : p_total->time + p_cost->time;
+}
+
+
+static uint8_t code_length(uint16_t code)
+{
+	uint8_t len = 0;
+
+	while (code > 1)
+	{
+		code >>= 1;
+		len++;
+	}
+	return len;
+}
+
+
+// add a code from a table to a cost, a code that isn't in the table can't be typed
+static void add_code(cost_t * p_cost, uint16_t const * p_entry, bool alt, cost_speed_t const * p_speed)
+{
+	uint8_t len;
+
+	if ((p_entry == NULL) || (p_cost->time == COST_NONE))
+	{
+		p_cost->time = COST_NONE;
+		return;
+	}
+	len = code_length(p_entry[0]);
+
+	if (alt)
+	{
+		p_cost->chords++;
+		p_cost->actions++;
+		p_cost->time += p_speed->press + p_speed->gap;
+	}
+	p_cost->actions += len;
+	p_cost->elements += len;
+	p_cost->time += (len * p_speed->press) + ((len - 1) * p_speed->gap);
+	if (p_entry[3] == CODE_LEAF)
+	{
+		p_cost->time += p_speed->gap;
+	}
+	else
+	{
+		p_cost->timeouts++;
+		p_cost->wait += advance_ms;
+		p_cost->time += advance_ms;
+	}
+}
+
+
+static uint16_t const * find_entry(uint16_t const (*table)[4], uint16_t table_size, uint16_t key, uint8_t modifiers)
+{
+	for (uint16_t i = 0; i < table_size; i++)
+	{
+		if ((table[i][1] == key) && (table[i][2] == modifiers))
+		{
+			return table[i];
+		}
+	}
+	return NULL;
+}
+
+
+/**@brief Function for the cost of typing a key in a state, without any free characters.
+ *
+ * @param[in]   key          Key code.
+ * @param[in]   modifiers    Modifiers it is sent with.
+ * @param[in]   state        State of the keyboard.
+ * @param[in]   p_speed      Operator speed.
+ * @param[out]  p_cost       Cost of the key.
+ *
+ * @return      false if the key can't be typed in the state.
+ */
+static bool key_cost(uint8_t key, uint8_t modifiers, enum cost_state state, cost_speed_t const * p_speed, cost_t * p_cost)
+{
+	uint16_t const (*table)[4] = (state == STATE_NUMERIC) ? numeric_key_table : key_table;
+	uint16_t size = (state == STATE_NUMERIC) ? NUMERIC_KEY_TABLE_SIZE : KEY_TABLE_SIZE;
+	uint16_t const * p_entry;
+
+	memset(p_cost, 0, sizeof(cost_t));
+
+	if (state == STATE_LOCKED)
+	{
+		// a locked shift is sent with every key, so only capitals and keys shift doesn't change
+		if ((modifiers == KEY_MOD_LSHIFT) && (key >= KEY_A) && (key <= KEY_Z))
+		{
+			modifiers = 0;
+		}
+		else if ((modifiers != 0) || ((key != KEY_SPACE) && (key != KEY_ENTER)))
+		{
+			return false;
+		}
+	}
+
+	// a code of its own, in the layer's table or the alt table
+	if ((p_entry = find_entry(table, size, key, modifiers)) != NULL)
+	{
+		add_code(p_cost, p_entry, false, p_speed);
+		return true;
+	}
+	if ((p_entry = find_entry(alt_key_table, ALT_KEY_TABLE_SIZE, key, modifiers)) != NULL)
+	{
+		add_code(p_cost, p_entry, true, p_speed);
+		return true;
+	}
+
+	// a shifted key typed with the shift alt code
+	if (modifiers == KEY_MOD_LSHIFT)
+	{
+		cost_t unshifted;
+		if (key_cost(key, 0, state, p_speed, &unshifted))
+		{
+			add_code(p_cost, find_entry(alt_key_table, ALT_KEY_TABLE_SIZE, FN_MOD_SHIFT, 0), true, p_speed);
+			p_cost->shifts++;
+			add(p_cost, &unshifted);
+			return p_cost->time != COST_NONE;
+		}
+	}
+	return false;
+}
+
+
+// cost of changing state between characters
+static void switch_cost(enum cost_state from, enum cost_state to, cost_speed_t const * p_speed, cost_t * p_cost)
+{
+	uint16_t const * p_shift = find_entry(alt_key_table, ALT_KEY_TABLE_SIZE, FN_MOD_SHIFT, 0);
+	uint16_t const * p_numeric = find_entry(alt_key_table, ALT_KEY_TABLE_SIZE, FN_NUMERIC_LAYER, 0);
+
+	memset(p_cost, 0, sizeof(cost_t));
+	if (from == to)
+	{
+		return;
+	}
+
+	// shift twice to lock it, once more to release it, the numeric layer is switched from standard
+	if (from == STATE_LOCKED)
+	{
+		add_code(p_cost, p_shift, true, p_speed);
+		p_cost->shifts++;
+	}
+	if ((from == STATE_NUMERIC) || (to == STATE_NUMERIC))
+	{
+		add_code(p_cost, p_numeric, true, p_speed);
+		p_cost->switches++;
+	}
+	if (to == STATE_LOCKED)
+	{
+		add_code(p_cost, p_shift, true, p_speed);
+		add_code(p_cost, p_shift, true, p_speed);
+		p_cost->shifts += 2;
+	}
+}
+
+
+static bool is_letter(char c)
+{
+	return isalpha((unsigned char)c) != 0;
+}
+
+
+// check if a character of the text is added by the keyboard (see send_code_key() in keyboard.c)
+static bool is_free(char const * p_text, size_t i)
+{
+	char c = p_text[i];
+
+	// the space after punctuation that ends a word, when a letter follows
+	if ((c == ' ') && (i >= 2) && strchr(".,;:!?", p_text[i - 1]) && is_letter(p_text[i - 2]) && is_letter(p_text[i + 1]))
+	{
+		return true;
+	}
+
+	// a capital at the start of a sentence
+	if (isupper((unsigned char)c) && (i > 0))
+	{
+		size_t j = i;
+		if (p_text[j - 1] == '\n')
+		{
+			return true;
+		}
+		if (p_text[j - 1] != ' ')
+		{
+			return false;
+		}
+		while ((j > 0) && (p_text[j - 1] == ' '))
+		{
+			j--;
+		}
+		return (j > 0) && strchr(".!?\n", p_text[j - 1]);
+	}
+	return false;
+}
+
+
+// keep the cheaper of two costs
+static void keep_best(cost_t * p_best, cost_t const * p_cost)
+{
+	if (p_cost->time < p_best->time)
+	{
+		*p_best = *p_cost;
+	}
+}
+
+
+/**@brief Function for the cheapest way to type a text.
+ *
+ * Each character is typed in whichever state is cheapest overall, found by following the cost of
+ * reaching every state after each character (the new line ends the numeric layer).
+ *
+ * @param[in]   p_text       Text.
+ * @param[in]   p_speed      Operator speed.
+ * @param[out]  p_total      Cost of the text.
+ * @param[out]  p_chars      Cost of each character (by character code), or NULL.
+ *
+ * @return      Characters skipped, which can't be typed.
+ */
+static uint32_t text_cost(char const * p_text, cost_speed_t const * p_speed, cost_t * p_total, cost_t * p_chars)
+{
+	cost_t state_cost[STATE_COUNT];
+	uint32_t skipped = 0;
+
+	memset(state_cost, 0, sizeof(state_cost));
+	for (uint8_t s = STATE_LOCKED; s < STATE_COUNT; s++)
+	{
+		state_cost[s].time = COST_NONE;
+	}
+
+	for (size_t i = 0; p_text[i] != '\0'; i++)
+	{
+		char c = p_text[i];
+		cost_t next[STATE_COUNT];
+		cost_t char_cost[STATE_COUNT];
+		uint8_t key;
+		uint8_t modifiers;
+		bool typed = false;
+
+		for (uint8_t s = 0; s < STATE_COUNT; s++)
+		{
+			next[s].time = COST_NONE;
+		}
+
+		if (c == '\n')
+		{
+			key = KEY_ENTER;
+			modifiers = 0;
+		}
+		else if (!sim_char_key(c, &key, &modifiers))
+		{
+			skipped++;
+			continue;
+		}
+
+		if (is_free(p_text, i))
+		{
+			for (uint8_t s = 0; s < STATE_COUNT; s++)
+			{
+				state_cost[s].chars++;
+			}
+			continue;
+		}
+
+		for (uint8_t to = 0; to < STATE_COUNT; to++)
+		{
+			if (!key_cost(key, modifiers, to, p_speed, &char_cost[to]))
+			{
+				continue;
+			}
+			for (uint8_t from = 0; from < STATE_COUNT; from++)
+			{
+				cost_t cost = state_cost[from];
+				cost_t change;
+
+				switch_cost(from, to, p_speed, &change);
+				add(&cost, &change);
+				add(&cost, &char_cost[to]);
+				keep_best(&next[((to == STATE_NUMERIC) && (c == '\n')) ? STATE_STANDARD : to], &cost);
+				typed = typed || (cost.time != COST_NONE);
+			}
+		}
+
+		if (!typed)
+		{
+			skipped++;
+			continue;
+		}
+		memcpy(state_cost, next, sizeof(state_cost));
+		for (uint8_t s = 0; s < STATE_COUNT; s++)
+		{
+			state_cost[s].chars++;
+		}
+
+		if (p_chars != NULL)
+		{
+			// the character's own cost, typed on its own from the standard state
+			for (uint8_t to = 0; to < STATE_COUNT; to++)
+			{
+				cost_t cost;
+				if (key_cost(key, modifiers, to, p_speed, &char_cost[to]))
+				{
+					switch_cost(STATE_STANDARD, to, p_speed, &cost);
+					add(&cost, &char_cost[to]);
+					char_cost[to] = cost;
+				}
+				else
+				{
+					char_cost[to].time = COST_NONE;
+				}
+			}
+			for (uint8_t to = 1; to < STATE_COUNT; to++)
+			{
+				keep_best(&char_cost[0], &char_cost[to]);
+			}
+			char_cost[0].chars = 1;
+			add(&p_chars[(uint8_t)c % COST_CHAR_COUNT], &char_cost[0]);
+		}
+	}
+
+	// the text ends with the keyboard back in its standard state
+	*p_total = state_cost[STATE_STANDARD];
+	for (uint8_t s = STATE_LOCKED; s < STATE_COUNT; s++)
+	{
+		cost_t cost = state_cost[s];
+		cost_t change;
+		switch_cost(s, STATE_STANDARD, p_speed, &change);
+		add(&cost, &change);
+		keep_best(p_total, &cost);
+	}
+	return skipped;
+}
+
+
+static void print_cost(char const * p_name, cost_t const * p_cost)
+{
+	double chars = MAX(p_cost->chars, 1);
+	double ms = p_cost->time / chars;
+
+	printf("%-12s %6u %7.2f %7.2f %7.2f %7.2f %7.1f %7.1f %7.1f\n", p_name, p_cost->chars, p_cost->actions / chars,
+		   p_cost->chords / chars, p_cost->elements / chars, p_cost->timeouts / chars, p_cost->wait / chars, ms,
+		   (ms > 0) ? 60000.0 / (ms * COST_WORD_LEN) : 0.0);
+}
+
+
+static void run_speed(char const * p_text, cost_speed_t const * p_speed)
+{
+	static cost_t chars[COST_CHAR_COUNT];
+	uint32_t skipped;
+	cost_t total;
+
+	memset(chars, 0, sizeof(chars));
+	skipped = text_cost(p_text, p_speed, &total, per_char ? chars : NULL);
+	print_cost(p_speed->p_name, &total);
+	printf("%-12s %u shifts, %u numeric layer switches, %u characters skipped\n", "", total.shifts, total.switches,
+		   skipped);
+
+	if (per_char)
+	{
+		for (uint16_t c = 0; c < COST_CHAR_COUNT; c++)
+		{
+			if (chars[c].chars > 0)
+			{
+				char name[24];
+				snprintf(name, sizeof(name), (c == ' ') ? "  space" : (c == '\n') ? "  enter" : "  '%c'", c);
+				print_cost(name, &chars[c]);
+			}
+		}
+	}
+}
+
+
+static char * read_file(char const * p_path)
+{
+	FILE * p_file = fopen(p_path, "r");
+	char * p_text;
+	long len;
+
+	if (p_file == NULL)
+	{
+		perror(p_path);
+		exit(2);
+	}
+	fseek(p_file, 0, SEEK_END);
+	len = ftell(p_file);
+	fseek(p_file, 0, SEEK_SET);
+	p_text = malloc(len + 1);
+	len = fread(p_text, 1, len, p_file);
+	p_text[len] = '\0';
+	fclose(p_file);
+	return p_text;
+}
+
+
+int main(int argc, char * argv[])
+{
+	char const * p_text = default_text;
+	keyboard_timing_t timing;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "cf:t:")) != -1)
+	{
+		switch (opt)
+		{
+		    case 'c':
+				per_char = true;
+				break;
+		    case 'f':
+				p_text = read_file(optarg);
+				break;
+		    case 't':
+				if ((speed_count == COST_MAX_SPEEDS) ||
+					(sscanf(optarg, "%u,%u", &speeds[speed_count].press, &speeds[speed_count].gap) != 2))
+				{
+					fprintf(stderr, "timing must be press,gap\n");
+					return 2;
+				}
+				speeds[speed_count++].p_name = optarg;
+				break;
+		    default:
+				fprintf(stderr, "usage: cost [-c] [-f text-file] [-t press,gap]...\n");
+				return 2;
+		}
+	}
+	if (speed_count == 0)
+	{
+		speed_count = sizeof(standard_speeds) / sizeof(standard_speeds[0]);
+		memcpy(speeds, standard_speeds, sizeof(standard_speeds));
+	}
+
+	// a code is ended once the advance count passes the advance time, on the poll cycle after
+	keyboard_get_timing(&timing);
+	advance_ms = (timing.advance_time + 1) * SIM_POLL_INTERVAL;
+
+	printf("advance time %u ms, times a character\n", advance_ms);
+	printf("%-12s %6s %7s %7s %7s %7s %7s %7s %7s\n", "operator", "chars", "presses", "chords", "elems", "timeouts",
+		   "wait", "ms", "wpm");
+	for (uint8_t i = 0; i < speed_count; i++)
+	{
+		run_speed(p_text, &speeds[i]);
+	}
+	return 0;
+}
@@ -0,0 +1,522 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#include "nordic_common.h"
+
+#include "sim.h"
+#include "typist.h"
+#include "fake_softdevice.h"
+
+/*
+ * Event traces recorded by event_trace.c, dumped from the device over RTT or recorded in the
+ * simulation, broken down into the stages a key passes through on its way to the host.
+ *
+ * usage: events timeline <dump>                 print each event with its time and the time since the last,
+ *                                               with the log messages recorded formatted
+ *        events stats [-b bucket-ms] <dump>     print the latency of each stage with a histogram (the
+ *                                               buckets are sized for each stage unless given)
+ *        events record [-f text-file] [-t press,gap,pause] [-i interval-us] <dump>
+ *                                               type a text through the decoder and hid_reports.c on the
+ *                                               fake SoftDevice and save the events recorded
+ *
+ * Stages, each measured for every key pattern sent:
+ *   decode    last release before a code to the code being processed (the advance time)
+ *   process   code processed to its first key pattern being sent
+ *   queue     key pattern sent to all of it being taken by the SoftDevice
+ *   radio     first key pattern taken after a TX complete to the next TX complete
+ *   key       release to the TX complete for the first key pattern sent after it
+ */
+
+#define EVENTS_MAX_RECORDS        4096
+#define EVENTS_MAX_PENDING        64            // key patterns waiting for the SoftDevice (MAX_BUFFER_ENTRIES and one being sent)
+#define EVENTS_SETTLE_TIME        3000          // time the keyboard is run for after the text is typed (in ms)
+#define EVENTS_HISTOGRAM_BUCKETS  16            // buckets shown, the last holds everything longer
+#define EVENTS_HISTOGRAM_WIDTH    40            // characters in the longest bar
+#define EVENTS_MIN_BUCKET         0.1           // narrowest automatic histogram bucket (in ms), the RTC counts in 61 us
+
+enum stage { STAGE_DECODE, STAGE_PROCESS, STAGE_QUEUE, STAGE_RADIO, STAGE_KEY, STAGE_COUNT };
+
+static const char * const stage_names[STAGE_COUNT] = { "decode", "process", "queue", "radio", "key" };
+
+static const char * const event_names[] =
+{
+	"press", "release", "code", "send", "accept", "drop", "tx complete", "connected", "disconnected", "log",
+};
+
+static const char * const key_names[] = { "power", "left", "right", "?" };
+
+static const char * const drop_reasons[] = { "queue full", "refused", "disconnected", "backlog", "?" };
+
+static const char default_text[] = "descend to 3000 feet";
+
+// A record with its time unwrapped from the counter
+typedef struct
+{
+	double time;                  // ms since the first record
+	uint8_t event;                // enum trace_event
+	uint8_t arg8;
+	uint16_t arg16;
+} event_t;
+
+static uint8_t data[SIM_MAX_TRACE];
+static event_t events[EVENTS_MAX_RECORDS];
+static double stage_times[STAGE_COUNT][EVENTS_MAX_RECORDS];
+static uint32_t stage_counts[STAGE_COUNT];
+
+
+static uint32_t read_u32(uint8_t const * p_data)
+{
+	return p_data[0] | (p_data[1] << 8) | (p_data[2] << 16) | ((uint32_t)p_data[3] << 24);
+}
+
+
+// find the events in a dump, which can have other output before them, returns the number read (-1 if none)
+static int32_t load(char const * p_path)
+{
+	uint32_t len = sim_trace_load(p_path, data, sizeof(data));
+
+	for (uint32_t i = 0; (i + EVENT_TRACE_HEADER_SIZE) <= len; i++)
+	{
+		if ((data[i] == 'M') && (data[i + 1] == 'E') && (data[i + 2] == EVENT_TRACE_VERSION))
+		{
+			uint8_t const * p_header = &data[i];
+			uint8_t bits = p_header[3];
+			uint32_t freq = read_u32(&p_header[4]);
+			uint16_t count = p_header[8] | (p_header[9] << 8);
+			uint8_t const * p_record = &p_header[EVENT_TRACE_HEADER_SIZE];
+			uint32_t mask = (bits >= 32) ? 0xFFFFFFFF : ((1u << bits) - 1);
+			uint64_t ticks = 0;
+			uint32_t last = 0;
+
+			if ((freq == 0) || (count > EVENTS_MAX_RECORDS) ||
+				((i + EVENT_TRACE_HEADER_SIZE + (count * EVENT_RECORD_SIZE)) > len))
+			{
+				break;
+			}
+
+			// the counter wraps, each record is taken to be less than a wrap after the one before
+			for (uint16_t n = 0; n < count; n++, p_record += EVENT_RECORD_SIZE)
+			{
+				uint32_t counter = read_u32(p_record);
+				ticks += (n > 0) ? ((counter - last) & mask) : 0;
+				last = counter;
+				events[n].time = (ticks * 1000.0) / freq;
+				events[n].event = p_record[4];
+				events[n].arg8 = p_record[5];
+				events[n].arg16 = p_record[6] | (p_record[7] << 8);
+			}
+			return count;
+		}
+	}
+
+	fprintf(stderr, "%s: no events found\n", p_path);
+	return -1;
+}
+
+
+static char const * event_name(uint8_t event)
+{
+	return (event < ARRAY_SIZE(event_names)) ? event_names[event] : "?";
+}
+
+
+static int timeline(char const * p_path)
+{
+	int32_t count = load(p_path);
+	double last = 0;
+	char const * p_format;
+	uint16_t values[2];
+
+	if (count < 0)
+	{
+		return 1;
+	}
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		event_t const * p_event = &events[i];
+		printf("%10.2f %+9.2f  %-12s ", p_event->time, p_event->time - last, event_name(p_event->event));
+		last = p_event->time;
+		switch (p_event->event)
+		{
+		    case EVENT_PRESS:
+		    case EVENT_RELEASE:
+				printf("%s\n", key_names[MIN(p_event->arg8, 3)]);
+				break;
+		    case EVENT_CODE:
+				printf("0x%04x\n", p_event->arg16);
+				break;
+		    case EVENT_SEND:
+				printf("key 0x%02x, %u keys\n", p_event->arg8, p_event->arg16);
+				break;
+		    case EVENT_ACCEPT:
+				printf("key 0x%02x, %u still queued\n", p_event->arg8, p_event->arg16);
+				break;
+		    case EVENT_DROP:
+				printf("%s, %u keys\n", drop_reasons[MIN(p_event->arg8, ARRAY_SIZE(drop_reasons) - 1)], p_event->arg16);
+				break;
+		    case EVENT_TX_COMPLETE:
+				printf("%u notifications\n", p_event->arg16);
+				break;
+		    case EVENT_DISCONNECTED:
+				printf("reason 0x%02x\n", p_event->arg16);
+				break;
+		    case EVENT_LOG:
+				if (event_log_format(p_event->arg8, p_event->arg16, &p_format, values))
+				{
+					printf(p_format, values[0], values[1]);
+					printf("\n");
+				}
+				else
+				{
+					printf("message %u, %u\n", p_event->arg8, p_event->arg16);
+				}
+				break;
+		    default:
+				printf("\n");
+				break;
+		}
+	}
+	printf("%d events over %.2f ms\n", count, (count > 0) ? events[count - 1].time : 0.0);
+	return 0;
+}
+
+
+static void add_stage(enum stage stage, double time)
+{
+	if (stage_counts[stage] < EVENTS_MAX_RECORDS)
+	{
+		stage_times[stage][stage_counts[stage]++] = time;
+	}
+}
+
+
+/**@brief Function for measuring the stages of the key patterns in a list of events.
+ *
+ * @details The report queue is first in first out, so key patterns are taken by the SoftDevice in
+ *          the order they were sent, except one lost as the queue was full or refused straight
+ *          away, which is the last sent.
+ */
+static void measure(event_t const * p_events, int32_t count)
+{
+	double pending[EVENTS_MAX_PENDING];           // time each key pattern waiting for the SoftDevice was sent
+	double pending_release[EVENTS_MAX_PENDING];   // release it was the first key pattern after, or -1
+	double accepted_release[EVENTS_MAX_PENDING];  // the same for key patterns waiting for a TX complete
+	uint8_t pending_count = 0;
+	uint8_t accepted_count = 0;
+	double last_accept = -1;                      // time of the first key pattern taken since the last TX complete
+	double release = -1;                          // last release not yet followed by a key pattern
+	double last_release = -1;
+	double code = -1;                             // code not yet followed by a key pattern
+
+	memset(stage_counts, 0, sizeof(stage_counts));
+	for (int32_t i = 0; i < count; i++)
+	{
+		event_t const * p_event = &p_events[i];
+		switch (p_event->event)
+		{
+		    case EVENT_PRESS:
+				// a code that sent nothing (a speculative key already sent, or a command) is over
+				code = -1;
+				break;
+		    case EVENT_RELEASE:
+				if (p_event->arg8 != POWER_KEY)
+				{
+					release = p_event->time;
+					last_release = p_event->time;
+				}
+				break;
+		    case EVENT_CODE:
+				if (last_release >= 0)
+				{
+					add_stage(STAGE_DECODE, p_event->time - last_release);
+				}
+				code = p_event->time;
+				break;
+		    case EVENT_SEND:
+				if (code >= 0)
+				{
+					add_stage(STAGE_PROCESS, p_event->time - code);
+					code = -1;
+				}
+				if (pending_count < EVENTS_MAX_PENDING)
+				{
+					pending[pending_count] = p_event->time;
+					pending_release[pending_count++] = release;
+				}
+				release = -1;
+				break;
+		    case EVENT_ACCEPT:
+		    case EVENT_DROP:
+				// keys lost from the backlog were never given to the report queue
+				if ((pending_count > 0) && !((p_event->event == EVENT_DROP) && (p_event->arg8 == EVENT_DROP_BACKLOG)))
+				{
+					bool last = (p_event->event == EVENT_DROP) && (p_event->arg8 != EVENT_DROP_DISCONNECTED);
+					uint8_t index = last ? pending_count - 1 : 0;
+					double sent = pending[index];
+					double first_release = pending_release[index];
+
+					pending_count--;
+					memmove(&pending[index], &pending[index + 1], (pending_count - index) * sizeof(double));
+					memmove(&pending_release[index], &pending_release[index + 1], (pending_count - index) * sizeof(double));
+					if (p_event->event == EVENT_ACCEPT)
+					{
+						add_stage(STAGE_QUEUE, p_event->time - sent);
+						if (last_accept < 0)
+						{
+							last_accept = p_event->time;
+						}
+						if ((first_release >= 0) && (accepted_count < EVENTS_MAX_PENDING))
+						{
+							accepted_release[accepted_count++] = first_release;
+						}
+					}
+				}
+				break;
+		    case EVENT_TX_COMPLETE:
+				if (last_accept >= 0)
+				{
+					add_stage(STAGE_RADIO, p_event->time - last_accept);
+					last_accept = -1;
+				}
+				for (uint8_t j = 0; j < accepted_count; j++)
+				{
+					add_stage(STAGE_KEY, p_event->time - accepted_release[j]);
+				}
+				accepted_count = 0;
+				break;
+		    case EVENT_DISCONNECTED:
+				// the notifications in flight are lost with the link
+				last_accept = -1;
+				accepted_count = 0;
+				break;
+		}
+	}
+}
+
+
+static int compare_double(void const * p_a, void const * p_b)
+{
+	double a = *(double const *)p_a;
+	double b = *(double const *)p_b;
+	return (a > b) - (a < b);
+}
+
+
+// nearest rank percentile of sorted values
+static double percentile(double const * p_values, uint32_t count, uint32_t percent)
+{
+	uint32_t rank = ((count * percent) + 99) / 100;
+	return p_values[(rank > 0) ? rank - 1 : 0];
+}
+
+
+// width of the histogram buckets for values up to a maximum, a round number of ms
+static double auto_bucket(double max)
+{
+	static const double steps[] = { 1, 2, 5 };
+	double scale = EVENTS_MIN_BUCKET;
+
+	for (;;)
+	{
+		for (uint8_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+		{
+			if ((steps[i] * scale * (EVENTS_HISTOGRAM_BUCKETS - 1)) > max)
+			{
+				return steps[i] * scale;
+			}
+		}
+		scale *= 10;
+	}
+}
+
+
+static void print_histogram(double const * p_values, uint32_t count, double bucket)
+{
+	uint32_t buckets[EVENTS_HISTOGRAM_BUCKETS] = { 0 };
+	uint32_t first = EVENTS_HISTOGRAM_BUCKETS;
+	uint32_t last = 0;
+	uint32_t most = 0;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint32_t b = MIN((uint32_t)(p_values[i] / bucket), EVENTS_HISTOGRAM_BUCKETS - 1);
+		buckets[b]++;
+		first = MIN(first, b);
+		last = MAX(last, b);
+	}
+	for (uint32_t b = first; b <= last; b++)
+	{
+		most = MAX(most, buckets[b]);
+	}
+
+	for (uint32_t b = first; b <= last; b++)
+	{
+		uint32_t width = (buckets[b] * EVENTS_HISTOGRAM_WIDTH + most - 1) / most;
+		if (b < EVENTS_HISTOGRAM_BUCKETS - 1)
+		{
+			printf("  %7.1f - %-7.1f %5u ", b * bucket, (b + 1) * bucket, buckets[b]);
+		}
+		else
+		{
+			printf("  %7.1f +        %5u ", b * bucket, buckets[b]);
+		}
+		for (uint32_t i = 0; i < width; i++)
+		{
+			putchar('#');
+		}
+		putchar('\n');
+	}
+}
+
+
+static int stats(char const * p_path, double bucket)
+{
+	int32_t count = load(p_path);
+
+	if (count < 0)
+	{
+		return 1;
+	}
+
+	measure(events, count);
+	printf("%d events over %.2f ms, stage latency (ms)\n", count, (count > 0) ? events[count - 1].time : 0.0);
+	printf("%-10s %6s %8s %8s %8s %8s %8s\n", "stage", "count", "min", "mean", "p50", "p95", "max");
+	for (uint32_t s = 0; s < STAGE_COUNT; s++)
+	{
+		double total = 0;
+
+		qsort(stage_times[s], stage_counts[s], sizeof(double), compare_double);
+		for (uint32_t i = 0; i < stage_counts[s]; i++)
+		{
+			total += stage_times[s][i];
+		}
+		if (stage_counts[s] == 0)
+		{
+			printf("%-10s %6u\n", stage_names[s], 0);
+			continue;
+		}
+		printf("%-10s %6u %8.2f %8.2f %8.2f %8.2f %8.2f\n", stage_names[s], stage_counts[s], stage_times[s][0],
+			   total / stage_counts[s], percentile(stage_times[s], stage_counts[s], 50),
+			   percentile(stage_times[s], stage_counts[s], 95), stage_times[s][stage_counts[s] - 1]);
+	}
+
+	for (uint32_t s = 0; s < STAGE_COUNT; s++)
+	{
+		if (stage_counts[s] > 0)
+		{
+			printf("\n%s\n", stage_names[s]);
+			print_histogram(stage_times[s], stage_counts[s],
+							(bucket > 0) ? bucket : auto_bucket(stage_times[s][stage_counts[s] - 1]));
+		}
+	}
+	return 0;
+}
+
+
+static char * read_file(char const * p_path)
+{
+	static char text[SIM_MAX_TEXT + 1];
+	FILE * p_file = fopen(p_path, "r");
+	size_t len;
+
+	if (p_file == NULL)
+	{
+		perror(p_path);
+		exit(1);
+	}
+	len = fread(text, 1, SIM_MAX_TEXT, p_file);
+	fclose(p_file);
+	while ((len > 0) && (text[len - 1] == '\n'))
+	{
+		len--;
+	}
+	text[len] = '\0';
+	return text;
+}
+
+
+static int record(char const * p_text, typist_timing_t const * p_timing, char const * p_out)
+{
+	static uint32_t release[SIM_MAX_TEXT];
+	FILE * p_file;
+	uint16_t len;
+
+	sim_init(false);
+	typist_type_text(p_text, p_timing, release, SIM_MAX_TEXT);
+	sim_advance(EVENTS_SETTLE_TIME);
+
+	p_file = fopen(p_out, "wb");
+	if (p_file == NULL)
+	{
+		perror(p_out);
+		return 1;
+	}
+	len = event_trace_read(0, data, event_trace_size());
+	fwrite(data, 1, len, p_file);
+	fclose(p_file);
+	printf("%s: host text \"%s\", %u events\n", p_out, sim.text, (len - EVENT_TRACE_HEADER_SIZE) / EVENT_RECORD_SIZE);
+	return 0;
+}
+
+
+int main(int argc, char * argv[])
+{
+	typist_timing_t timing = TYPIST_DEFAULT_TIMING;
+	char const * p_text = default_text;
+	double bucket = 0;
+	int opt;
+
+	if ((argc == 3) && (strcmp(argv[1], "timeline") == 0))
+	{
+		return timeline(argv[2]);
+	}
+
+	optind = 2;
+	if ((argc >= 3) && (strcmp(argv[1], "stats") == 0))
+	{
+		bool valid = true;
+		while ((opt = getopt(argc, argv, "b:")) != -1)
+		{
+			bucket = (opt == 'b') ? strtod(optarg, NULL) : 0;
+			valid &= bucket > 0;
+		}
+		if (valid && ((argc - optind) == 1))
+		{
+			return stats(argv[optind], bucket);
+		}
+	}
+	else if ((argc >= 3) && (strcmp(argv[1], "record") == 0))
+	{
+		bool valid = true;
+		while ((opt = getopt(argc, argv, "f:t:i:")) != -1)
+		{
+			switch (opt)
+			{
+			    case 'f':
+					p_text = read_file(optarg);
+					break;
+			    case 't':
+					valid &= sscanf(optarg, "%u,%u,%u", &timing.press, &timing.gap, &timing.pause) == 3;
+					break;
+			    case 'i':
+					fake_sd_config.interval_us = strtoul(optarg, NULL, 10);
+					break;
+			    default:
+					valid = false;
+					break;
+			}
+		}
+		if (valid && ((argc - optind) == 1))
+		{
+			return record(p_text, &timing, argv[optind]);
+		}
+	}
+
+	fprintf(stderr, "usage: events timeline <dump>\n"
+			"       events stats [-b bucket-ms] <dump>\n"
+			"       events record [-f text-file] [-t press,gap,pause] [-i interval-us] <dump>\n");
+	return 2;
+}
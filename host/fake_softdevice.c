@@ -0,0 +1,264 @@
+#include <string.h>
+
+#include "nordic_common.h"
+#include "app_error.h"
+#include "ble_hids.h"
+
+#include "sim.h"
+#include "fake_softdevice.h"
+#include "hid_reports.h"
+
+#define FAKE_SD_CONN_HANDLE       0
+
+fake_sd_config_t fake_sd_config = { "default", 15000, 6, 1, 3, 0, 0, 0 };
+fake_sd_stats_t fake_sd_stats;
+
+static ble_hids_t m_hids;
+static uint16_t m_conn_handle = BLE_CONN_HANDLE_INVALID;
+
+// Notifications waiting to be sent
+static uint8_t queue[FAKE_SD_MAX_QUEUE][INPUT_REPORT_KEYS_MAX_LEN];
+static uint8_t queue_rp = 0;
+static uint8_t queue_count = 0;
+
+// Time of the next connection event (in us)
+static uint64_t next_event_time = 0;
+
+// Keys pressed in the last report the host received
+static uint8_t host_keys[INPUT_REPORT_KEYS_MAX_LEN - 2];
+
+// Times TX complete events are due (in us), with the notifications each reports
+static uint64_t tx_complete_time[FAKE_SD_MAX_TX_COMPLETE];
+static uint8_t tx_complete_sent[FAKE_SD_MAX_TX_COMPLETE];
+static uint8_t tx_complete_count = 0;
+
+// The low power connection parameters are in use, each connection starts with the normal ones
+static bool low_power_mode = false;
+
+static uint32_t random_state = 1;
+
+
+void fake_sd_seed(uint32_t seed)
+{
+	random_state = (seed != 0) ? seed : 1;
+}
+
+
+// xorshift32
+static uint32_t random_next(void)
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+
+static bool random_chance(uint8_t percent)
+{
+	return (percent > 0) && ((random_next() % 100) < percent);
+}
+
+
+static uint32_t notification_queue(uint16_t len, uint8_t * p_data, uint16_t conn_handle)
+{
+	if ((conn_handle != m_conn_handle) || (m_conn_handle == BLE_CONN_HANDLE_INVALID))
+	{
+		return NRF_ERROR_INVALID_STATE;
+	}
+	if (random_chance(fake_sd_config.busy_percent))
+	{
+		fake_sd_stats.busy_errors++;
+		return NRF_ERROR_BUSY;
+	}
+	if ((queue_count >= MIN(fake_sd_config.hvn_queue_size, FAKE_SD_MAX_QUEUE)) ||
+		random_chance(fake_sd_config.resources_percent))
+	{
+		fake_sd_stats.resources_errors++;
+		return NRF_ERROR_RESOURCES;
+	}
+
+	memcpy(queue[(queue_rp + queue_count) % FAKE_SD_MAX_QUEUE], p_data, MIN(len, INPUT_REPORT_KEYS_MAX_LEN));
+	queue_count++;
+	fake_sd_stats.queue_high_water = MAX(fake_sd_stats.queue_high_water, queue_count);
+	return NRF_SUCCESS;
+}
+
+
+uint32_t ble_hids_inp_rep_send(ble_hids_t * p_hids, uint8_t rep_index, uint16_t len, uint8_t * p_data, uint16_t conn_handle)
+{
+	UNUSED_PARAMETER(p_hids);
+	UNUSED_PARAMETER(rep_index);
+	return notification_queue(len, p_data, conn_handle);
+}
+
+
+uint32_t ble_hids_boot_kb_inp_rep_send(ble_hids_t * p_hids, uint16_t len, uint8_t * p_data, uint16_t conn_handle)
+{
+	UNUSED_PARAMETER(p_hids);
+	return notification_queue(len, p_data, conn_handle);
+}
+
+
+// the host types each key that is pressed in a report and wasn't in the last one
+static void host_report(uint8_t const * p_report)
+{
+	uint8_t const * p_keys = &p_report[2];
+
+	for (uint8_t i = 0; i < sizeof(host_keys); i++)
+	{
+		if ((p_keys[i] != 0) && (memchr(host_keys, p_keys[i], sizeof(host_keys)) == NULL))
+		{
+			sim_host_key(p_report[0], p_keys[i]);
+		}
+	}
+	memcpy(host_keys, p_keys, sizeof(host_keys));
+}
+
+
+static void tx_complete_raise(uint64_t time, uint8_t sent)
+{
+	uint64_t delay = (fake_sd_config.tx_complete_delay_us > 0) ? random_next() % (fake_sd_config.tx_complete_delay_us + 1) : 0;
+
+	if (tx_complete_count < FAKE_SD_MAX_TX_COMPLETE)
+	{
+		tx_complete_time[tx_complete_count] = time + delay;
+		tx_complete_sent[tx_complete_count++] = sent;
+	}
+}
+
+
+static void connection_event(uint64_t time)
+{
+	uint8_t sent = 0;
+
+	fake_sd_stats.events++;
+	if ((queue_count == 0) && ((fake_sd_stats.events % (fake_sd_config.latency + 1)) != 0))
+	{
+		return;
+	}
+	fake_sd_stats.events_listened++;
+
+	while ((queue_count > 0) && (sent < fake_sd_config.per_event))
+	{
+		host_report(queue[queue_rp]);
+		queue_rp = (queue_rp + 1) % FAKE_SD_MAX_QUEUE;
+		queue_count--;
+		sent++;
+	}
+
+	if (sent > 0)
+	{
+		fake_sd_stats.notifications += sent;
+		tx_complete_raise(time, sent);
+	}
+}
+
+
+void sim_link_init(void)
+{
+	memset(&fake_sd_stats, 0, sizeof(fake_sd_stats));
+	memset(host_keys, 0, sizeof(host_keys));
+	queue_rp = 0;
+	queue_count = 0;
+	tx_complete_count = 0;
+	next_event_time = fake_sd_config.interval_us;
+
+	hid_reports_init(&m_hids);
+	sim_link_set_connected(true);
+}
+
+
+void sim_link_advance(uint32_t time)
+{
+	uint64_t now = (uint64_t)time * 1000;
+
+	while (next_event_time <= now)
+	{
+		if (m_conn_handle != BLE_CONN_HANDLE_INVALID)
+		{
+			connection_event(next_event_time);
+		}
+		next_event_time += fake_sd_config.interval_us;
+	}
+
+	for (uint8_t i = 0; i < tx_complete_count; )
+	{
+		if (tx_complete_time[i] <= now)
+		{
+			// as ble_evt_handler() in bluetooth.c
+			EVENT_PROBE(EVENT_TX_COMPLETE, 0, tx_complete_sent[i]);
+			tx_complete_count--;
+			tx_complete_time[i] = tx_complete_time[tx_complete_count];
+			tx_complete_sent[i] = tx_complete_sent[tx_complete_count];
+			hid_reports_tx_complete();
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	// the button poll timer retries the queue (see timers.c)
+	if ((time % SIM_POLL_INTERVAL) == 0)
+	{
+		hid_reports_poll();
+	}
+}
+
+
+void sim_link_set_connected(bool connected)
+{
+	if (connected)
+	{
+		m_conn_handle = FAKE_SD_CONN_HANDLE;
+		low_power_mode = false;
+		EVENT_PROBE(EVENT_CONNECTED, 0, 0);
+		hid_reports_connected(m_conn_handle);
+	}
+	else
+	{
+		// notifications not yet sent are lost with the link
+		m_conn_handle = BLE_CONN_HANDLE_INVALID;
+		EVENT_PROBE(EVENT_DISCONNECTED, 0, 0);
+		fake_sd_stats.lost += queue_count;
+		queue_count = 0;
+		tx_complete_count = 0;
+		memset(host_keys, 0, sizeof(host_keys));
+		hid_reports_disconnected();
+	}
+}
+
+
+bool bluetooth_is_connected(void)
+{
+	return m_conn_handle != BLE_CONN_HANDLE_INVALID;
+}
+
+
+bool bluetooth_caps_lock_on(void)
+{
+	return false;
+}
+
+
+void bluetooth_pair(void)
+{
+	sim_log("Pair");
+}
+
+
+void bluetooth_next_peer(void)
+{
+	sim_log("Next Peer");
+}
+
+
+void bluetooth_toggle_power_profile(void)
+{
+	if (m_conn_handle != BLE_CONN_HANDLE_INVALID)
+	{
+		low_power_mode = !low_power_mode;
+		sim_log("Power Profile: %d", low_power_mode);
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef FAKE_SOFTDEVICE_H
+#define FAKE_SOFTDEVICE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Fake SoftDevice for the HID report path in hid_reports.c. Notifications are queued as the
+ * SoftDevice queues them (up to hvn_queue_size, then NRF_ERROR_RESOURCES) and sent to the host at
+ * connection events, per_event at a time. A BLE_GATTS_EVT_HVN_TX_COMPLETE is raised after each
+ * connection event that sent something.
+ *
+ * With peripheral latency the keyboard only listens to every (latency + 1)th connection event, but
+ * like the SoftDevice it wakes for the next one as soon as it has something to send, so latency only
+ * changes the number of radio events, not when keys arrive.
+ *
+ * Faults can be injected for stress testing: sends refused at random with NRF_ERROR_RESOURCES or
+ * NRF_ERROR_BUSY, and TX complete events delayed by a random time. The random numbers are seeded
+ * so a run can be repeated.
+ */
+
+#define FAKE_SD_MAX_QUEUE         32
+#define FAKE_SD_MAX_TX_COMPLETE   64            // TX complete events that can be waiting to be raised
+
+typedef struct
+{
+	char const * p_name;
+	uint32_t interval_us;         // connection interval (in us)
+	uint16_t latency;             // peripheral latency (connection events)
+	uint8_t hvn_queue_size;       // notifications the SoftDevice can hold
+	uint8_t per_event;            // notifications sent in each connection event
+	uint8_t resources_percent;    // chance of a send being refused with NRF_ERROR_RESOURCES with room in the queue
+	uint8_t busy_percent;         // chance of a send being refused with NRF_ERROR_BUSY
+	uint32_t tx_complete_delay_us;  // most time a TX complete event is raised after its connection event
+} fake_sd_config_t;
+
+typedef struct
+{
+	uint32_t notifications;       // notifications sent to the host
+	uint32_t resources_errors;    // sends refused with NRF_ERROR_RESOURCES
+	uint32_t busy_errors;         // sends refused with NRF_ERROR_BUSY
+	uint32_t lost;                // notifications lost when the link dropped
+	uint32_t events;              // connection events
+	uint32_t events_listened;     // connection events the keyboard woke for
+	uint8_t queue_high_water;     // most notifications waiting in the SoftDevice
+} fake_sd_stats_t;
+
+extern fake_sd_config_t fake_sd_config;
+extern fake_sd_stats_t fake_sd_stats;
+
+// seed the random numbers used for fault injection
+void fake_sd_seed(uint32_t seed);
+
+#endif // FAKE_SOFTDEVICE_H
@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "sim.h"
+
+/*
+ * Runs press timeline scripts through the keyboard on a virtual clock.
+ *
+ * usage: keysim [-v] script...
+ *
+ * Each script is run in its own process from a freshly started keyboard. The exit status is 0 if
+ * every expectation in every script was met.
+ */
+
+
+static int run_script(char const * p_path, bool verbose)
+{
+	int failures;
+
+	sim_init(verbose);
+	failures = sim_run_script(p_path);
+	if (verbose || (failures != 0))
+	{
+		printf("%s: host text \"%s\" after %u ms, %u keys\n", p_path, sim.text, sim.time, sim.report_count);
+	}
+	return failures;
+}
+
+
+int main(int argc, char * argv[])
+{
+	bool verbose = false;
+	int failed = 0;
+	int first = 1;
+
+	if ((argc > 1) && (strcmp(argv[1], "-v") == 0))
+	{
+		verbose = true;
+		first++;
+	}
+	if (first >= argc)
+	{
+		fprintf(stderr, "usage: keysim [-v] script...\n");
+		return 2;
+	}
+
+	for (int i = first; i < argc; i++)
+	{
+		int status;
+		pid_t pid;
+
+		fflush(stdout);
+		pid = fork();
+
+		if (pid == 0)
+		{
+			int failures = run_script(argv[i], verbose);
+			fflush(stdout);
+			_exit((failures == 0) ? 0 : 1);
+		}
+		waitpid(pid, &status, 0);
+
+		bool passed = WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+		printf("%-40s %s\n", argv[i], passed ? "ok" : "FAILED");
+		failed += passed ? 0 : 1;
+	}
+
+	return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <getopt.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "nordic_common.h"
+
+#include "sim.h"
+#include "typist.h"
+#include "fake_softdevice.h"
+
+/*
+ * Keystroke latency benchmark. Text is typed through the decoder and hid_reports.c on the fake
+ * SoftDevice, and for every character the time from the release of its last element to it
+ * reaching the host is measured.
+ *
+ * usage: latency [-c] [-f text-file] [-t press,gap,pause] [-i interval-us] [-l latency] [-q queue] [-e per-event]
+ *
+ *   -c    also print the latency of each character
+ *   -f    text to type (default a set of ATC instructions)
+ *   -t    operator timing in ms (default 80,80,300)
+ *   -i -l -q -e    run one link configuration instead of the standard set
+ */
+
+#define LATENCY_MAX_CHARS         SIM_MAX_TEXT
+#define LATENCY_CHAR_COUNT        128
+
+static const char default_text[] =
+	"runway 27 left wind 250 at 10 knots "
+	"turn left heading 090 descend to 3000 feet "
+	"contact approach 119 5 "
+	"climb and maintain flight level 240 "
+	"squawk 4521 "
+	"hold short of taxiway bravo";
+
+// Link configurations, the connection interval the central picks is between MIN_CONN_INTERVAL and
+// MAX_CONN_INTERVAL (7.5 to 30 ms), the low power profile is 30 to 60 ms with a latency of 20
+static const fake_sd_config_t standard_configs[] =
+{
+	{ "7.5ms",              7500, 6, 1, 3, 0, 0, 0 },
+	{ "15ms",              15000, 6, 1, 3, 0, 0, 0 },
+	{ "30ms",              30000, 6, 1, 3, 0, 0, 0 },
+	{ "30ms queue 4",      30000, 6, 4, 3, 0, 0, 0 },
+	{ "30ms 1 per event",  30000, 6, 1, 1, 0, 0, 0 },
+	{ "low power 60ms",    60000, 20, 1, 3, 0, 0, 0 },
+};
+
+static bool per_char = false;
+static typist_timing_t timing = TYPIST_DEFAULT_TIMING;
+
+
+static int compare_u32(void const * p_a, void const * p_b)
+{
+	uint32_t a = *(uint32_t const *)p_a;
+	uint32_t b = *(uint32_t const *)p_b;
+	return (a > b) - (a < b);
+}
+
+
+// nearest rank percentile of sorted values
+static uint32_t percentile(uint32_t const * p_values, uint32_t count, uint32_t percent)
+{
+	uint32_t rank = ((count * percent) + 99) / 100;
+	return p_values[(rank > 0) ? rank - 1 : 0];
+}
+
+
+static void print_stats(char const * p_name, uint32_t * p_values, uint32_t count, char const * p_extra)
+{
+	uint64_t total = 0;
+
+	qsort(p_values, count, sizeof(uint32_t), compare_u32);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		total += p_values[i];
+	}
+	printf("%-20s %6u %6.1f %6u %6u %6u %6u %s\n", p_name, count, (count > 0) ? (double)total / count : 0.0,
+		   percentile(p_values, count, 50), percentile(p_values, count, 90), percentile(p_values, count, 99),
+		   (count > 0) ? p_values[count - 1] : 0, p_extra);
+}
+
+
+static void run_config(char const * p_text)
+{
+	static uint32_t release[LATENCY_MAX_CHARS];
+	static uint32_t latency[LATENCY_MAX_CHARS];
+	static uint32_t char_latency[LATENCY_CHAR_COUNT][LATENCY_MAX_CHARS];
+	static uint32_t char_count[LATENCY_CHAR_COUNT];
+	char expected[LATENCY_MAX_CHARS + 1];
+	uint16_t expected_len = 0;
+	uint32_t count = 0;
+	uint32_t errors = 0;
+	char extra[128];
+
+	for (char const * p = p_text; (*p != '\0') && (expected_len < LATENCY_MAX_CHARS); p++)
+	{
+		uint16_t code;
+		bool alt;
+		if (typist_find_code(*p, &code, &alt))
+		{
+			expected[expected_len++] = *p;
+		}
+	}
+	expected[expected_len] = '\0';
+
+	sim_init(false);
+	typist_type_text(expected, &timing, release, LATENCY_MAX_CHARS);
+	sim_advance(1000);
+
+	// the host text can differ in case (auto capitalisation), any other difference is an error
+	for (uint16_t i = 0; i < expected_len; i++)
+	{
+		if ((i >= sim.text_len) || (tolower((unsigned char)sim.text[i]) != tolower((unsigned char)expected[i])))
+		{
+			errors++;
+			continue;
+		}
+
+		uint32_t value = sim.text_time[i] - release[i];
+		uint8_t c = (uint8_t)expected[i] % LATENCY_CHAR_COUNT;
+		latency[count++] = value;
+		char_latency[c][char_count[c]++] = value;
+	}
+	errors += (sim.text_len > expected_len) ? sim.text_len - expected_len : 0;
+
+	snprintf(extra, sizeof(extra), "%6u %8.2f %6u %6u %6u", errors, (double)fake_sd_stats.notifications / MAX(expected_len, 1),
+			 fake_sd_stats.resources_errors, fake_sd_stats.queue_high_water, fake_sd_stats.events_listened);
+	print_stats(fake_sd_config.p_name, latency, count, extra);
+
+	if (per_char)
+	{
+		for (uint16_t c = 0; c < LATENCY_CHAR_COUNT; c++)
+		{
+			if (char_count[c] > 0)
+			{
+				char name[24];
+				snprintf(name, sizeof(name), "  '%c'", (c == ' ') ? '_' : c);
+				print_stats(name, char_latency[c], char_count[c], "");
+			}
+		}
+	}
+}
+
+
+static char * read_file(char const * p_path)
+{
+	static char text[LATENCY_MAX_CHARS + 1];
+	FILE * p_file = fopen(p_path, "r");
+	size_t len;
+
+	if (p_file == NULL)
+	{
+		perror(p_path);
+		exit(2);
+	}
+	len = fread(text, 1, LATENCY_MAX_CHARS, p_file);
+	text[len] = '\0';
+	fclose(p_file);
+
+	// lines are joined with spaces, a new line would capitalise the next word
+	for (size_t i = 0; i < len; i++)
+	{
+		text[i] = (text[i] == '\n') ? ' ' : tolower((unsigned char)text[i]);
+	}
+	return text;
+}
+
+
+int main(int argc, char * argv[])
+{
+	char const * p_text = default_text;
+	fake_sd_config_t custom = { "custom", 15000, 6, 1, 3, 0, 0, 0 };
+	bool use_custom = false;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "cf:t:i:l:q:e:")) != -1)
+	{
+		switch (opt)
+		{
+		    case 'c':
+				per_char = true;
+				break;
+		    case 'f':
+				p_text = read_file(optarg);
+				break;
+		    case 't':
+				if (sscanf(optarg, "%u,%u,%u", &timing.press, &timing.gap, &timing.pause) != 3)
+				{
+					fprintf(stderr, "timing must be press,gap,pause\n");
+					return 2;
+				}
+				break;
+		    case 'i':
+				custom.interval_us = strtoul(optarg, NULL, 10);
+				use_custom = true;
+				break;
+		    case 'l':
+				custom.latency = strtoul(optarg, NULL, 10);
+				use_custom = true;
+				break;
+		    case 'q':
+				custom.hvn_queue_size = strtoul(optarg, NULL, 10);
+				use_custom = true;
+				break;
+		    case 'e':
+				custom.per_event = strtoul(optarg, NULL, 10);
+				use_custom = true;
+				break;
+		    default:
+				fprintf(stderr, "usage: latency [-c] [-f text-file] [-t press,gap,pause] [-i interval-us] [-l latency] [-q queue] [-e per-event]\n");
+				return 2;
+		}
+	}
+
+	printf("release to host latency (ms), timing %u/%u/%u ms\n", timing.press, timing.gap, timing.pause);
+	printf("%-20s %6s %6s %6s %6s %6s %6s %6s %8s %6s %6s %6s\n", "config", "chars", "mean", "p50", "p90", "p99", "max",
+		   "errors", "reports", "busy", "queue", "wakeups");
+
+	uint32_t config_count = use_custom ? 1 : sizeof(standard_configs) / sizeof(standard_configs[0]);
+	for (uint32_t i = 0; i < config_count; i++)
+	{
+		int status;
+		pid_t pid;
+
+		// each configuration starts from a fresh keyboard in its own process
+		fflush(stdout);
+		pid = fork();
+		if (pid == 0)
+		{
+			fake_sd_config = use_custom ? custom : standard_configs[i];
+			run_config(p_text);
+			fflush(stdout);
+			_exit(0);
+		}
+		waitpid(pid, &status, 0);
+	}
+	return 0;
+}
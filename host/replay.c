@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "sim.h"
+
+/*
+ * Replay of press traces recorded by trace.c. Each edge is applied just before the poll cycle it
+ * was read in, counted from the poll cycle the replay starts at, so the decoder sees exactly the
+ * readings it saw on the device. A trace recorded from start up replayed on a fresh keyboard
+ * repeats the session exactly.
+ */
+
+
+static uint32_t read_u32(uint8_t const * p_data)
+{
+	return p_data[0] | (p_data[1] << 8) | (p_data[2] << 16) | ((uint32_t)p_data[3] << 24);
+}
+
+
+bool sim_trace_parse(uint8_t const * p_data, uint32_t len, sim_trace_t * p_trace)
+{
+	// a dump can have other output before it, find its header
+	for (uint32_t i = 0; (i + TRACE_HEADER_SIZE) <= len; i++)
+	{
+		if ((p_data[i] == 'M') && (p_data[i + 1] == 'T') && (p_data[i + 2] == TRACE_VERSION))
+		{
+			uint8_t const * p_header = &p_data[i];
+			p_trace->start_state = p_header[3];
+			p_trace->start_time = read_u32(&p_header[4]);
+			p_trace->len = p_header[8] | (p_header[9] << 8);
+			p_trace->p_edges = &p_header[TRACE_HEADER_SIZE];
+			return (i + TRACE_HEADER_SIZE + p_trace->len) <= len;
+		}
+	}
+	return false;
+}
+
+
+bool sim_trace_next(sim_trace_t const * p_trace, uint32_t * p_pos, sim_trace_edge_t * p_edge)
+{
+	uint32_t pos = *p_pos;
+	uint8_t header;
+	uint32_t delta;
+
+	if (pos >= p_trace->len)
+	{
+		return false;
+	}
+
+	header = p_trace->p_edges[pos++];
+	delta = header >> 3;
+	if (delta == TRACE_DELTA_ESCAPE)
+	{
+		uint8_t shift = 0;
+		uint8_t value;
+		do
+		{
+			if (pos >= p_trace->len)
+			{
+				return false;
+			}
+			value = p_trace->p_edges[pos++];
+			delta += (uint32_t)(value & 0x7F) << shift;
+			shift += 7;
+		} while (value & 0x80);
+	}
+
+	p_edge->key = header & 0x03;
+	p_edge->down = (header & 0x04) != 0;
+	p_edge->delta = delta;
+	*p_pos = pos;
+	return true;
+}
+
+
+uint32_t sim_trace_load(char const * p_path, uint8_t * p_data, uint32_t size)
+{
+	FILE * p_file = fopen(p_path, "rb");
+	uint32_t len;
+
+	if (p_file == NULL)
+	{
+		perror(p_path);
+		return 0;
+	}
+	len = fread(p_data, 1, size, p_file);
+	fclose(p_file);
+	return len;
+}
+
+
+bool sim_replay_trace(sim_trace_t const * p_trace)
+{
+	uint32_t base = sim.time / SIM_POLL_INTERVAL;
+	uint32_t poll = 0;
+	uint32_t pos = 0;
+	sim_trace_edge_t edge;
+
+	for (uint8_t key = POWER_KEY; key <= RIGHT_KEY; key++)
+	{
+		sim_set_key(key, (p_trace->start_state & (1 << key)) != 0);
+	}
+
+	while (sim_trace_next(p_trace, &pos, &edge))
+	{
+		if (edge.key > RIGHT_KEY)
+		{
+			return false;
+		}
+
+		// the reading changes between the poll cycle before the edge and the one it was read in
+		poll += edge.delta;
+		if ((base + poll) > 0)
+		{
+			sim_advance_to(((base + poll) * SIM_POLL_INTERVAL) - 1);
+		}
+		sim_set_key(edge.key, edge.down);
+	}
+	return pos == p_trace->len;
+}
@@ -0,0 +1,236 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+#include "typist.h"
+
+/*
+ * Press timeline scripts, one command per line ('#' starts a comment). Times are in ms of
+ * virtual time, and each command runs the keyboard for as long as it takes.
+ *
+ *   press <ms>              how long code elements are pressed for (default 80)
+ *   gap <ms>                time between the elements of a code (default 80)
+ *   pause <ms>              time after a code for it to be sent (default 300)
+ *   code <code>...          type each code, '.' is the left button and '-' the right, a code
+ *                           ending in :<ms> has its last element held for that time
+ *   alt <code>...           type each code with both buttons pressed first for the alt keys
+ *   down <L|R|P>            press the left, right or power button
+ *   up <L|R|P>              release a button
+ *   wait <ms>               run the keyboard for a time
+ *   connect, disconnect     change the link state
+ *   replay <file>           replay a press trace recorded on the device (relative to the script)
+ *   expect <text>           check the host text, \n \t and \\ can be used
+ *   expect-reports <count>  check the number of keys that have reached the host
+ */
+
+#define SCRIPT_MAX_LINE           256
+
+static bool parse_key(char const * p_name, enum board_key * p_key)
+{
+	switch (p_name[0])
+	{
+	    case 'L':
+			*p_key = LEFT_KEY;
+			return true;
+	    case 'R':
+			*p_key = RIGHT_KEY;
+			return true;
+	    case 'P':
+			*p_key = POWER_KEY;
+			return true;
+	    default:
+			return false;
+	}
+}
+
+
+// type the elements of a code, with the last element held for a time if it is given
+static bool type_code(char * p_code, bool alt, typist_timing_t const * p_timing)
+{
+	uint32_t last_press = p_timing->press;
+	char * p_hold = strchr(p_code, ':');
+
+	if (p_hold != NULL)
+	{
+		*p_hold = '\0';
+		last_press = strtoul(p_hold + 1, NULL, 10);
+	}
+	return typist_type_elements(p_code, alt, last_press, p_timing, NULL);
+}
+
+
+// unescape the text of an expect command in place
+static void unescape(char * p_text)
+{
+	char * p_out = p_text;
+
+	for (char * p = p_text; *p != '\0'; p++)
+	{
+		if ((*p == '\\') && (p[1] != '\0'))
+		{
+			p++;
+			*p_out++ = (*p == 'n') ? '\n' : ((*p == 't') ? '\t' : *p);
+		}
+		else
+		{
+			*p_out++ = *p;
+		}
+	}
+	*p_out = '\0';
+}
+
+
+// replay a trace, a relative path is from the directory of the script
+static bool replay(char const * p_file, char const * p_script)
+{
+	static uint8_t data[SIM_MAX_TRACE];
+	char path[SCRIPT_MAX_LINE * 2];
+	char const * p_dir_end = strrchr(p_script, '/');
+	sim_trace_t trace;
+	uint32_t len;
+
+	if ((p_file[0] == '/') || (p_dir_end == NULL))
+	{
+		snprintf(path, sizeof(path), "%s", p_file);
+	}
+	else
+	{
+		snprintf(path, sizeof(path), "%.*s/%s", (int)(p_dir_end - p_script), p_script, p_file);
+	}
+
+	len = sim_trace_load(path, data, sizeof(data));
+	return sim_trace_parse(data, len, &trace) && sim_replay_trace(&trace);
+}
+
+
+static bool run_line(char * p_line, typist_timing_t * p_timing, int * p_failures, char const * p_path, int line_num)
+{
+	char * p_rest;
+	char * p_command = strtok_r(p_line, " \t", &p_rest);
+	char * p_arg;
+
+	if ((p_command == NULL) || (p_command[0] == '#'))
+	{
+		return true;
+	}
+
+	if (strcmp(p_command, "expect") == 0)
+	{
+		char * p_text = (p_rest != NULL) ? p_rest : "";
+		unescape(p_text);
+		if (strcmp(p_text, sim.text) != 0)
+		{
+			printf("%s:%d: %u ms: expected \"%s\", host has \"%s\"\n", p_path, line_num, sim.time, p_text, sim.text);
+			(*p_failures)++;
+		}
+		return true;
+	}
+
+	p_arg = strtok_r(NULL, " \t", &p_rest);
+
+	if ((strcmp(p_command, "code") == 0) || (strcmp(p_command, "alt") == 0))
+	{
+		for (; p_arg != NULL; p_arg = strtok_r(NULL, " \t", &p_rest))
+		{
+			if (!type_code(p_arg, p_command[0] == 'a', p_timing))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	if (p_arg == NULL)
+	{
+		if (strcmp(p_command, "connect") == 0)
+		{
+			sim_set_connected(true);
+			return true;
+		}
+		if (strcmp(p_command, "disconnect") == 0)
+		{
+			sim_set_connected(false);
+			return true;
+		}
+		return false;
+	}
+
+	if (strcmp(p_command, "replay") == 0)
+	{
+		return replay(p_arg, p_path);
+	}
+
+	if ((strcmp(p_command, "down") == 0) || (strcmp(p_command, "up") == 0))
+	{
+		enum board_key key;
+		if (!parse_key(p_arg, &key))
+		{
+			return false;
+		}
+		sim_set_key(key, p_command[0] == 'd');
+		return true;
+	}
+
+	uint32_t value = strtoul(p_arg, NULL, 10);
+
+	if (strcmp(p_command, "press") == 0)
+	{
+		p_timing->press = value;
+	}
+	else if (strcmp(p_command, "gap") == 0)
+	{
+		p_timing->gap = value;
+	}
+	else if (strcmp(p_command, "pause") == 0)
+	{
+		p_timing->pause = value;
+	}
+	else if (strcmp(p_command, "wait") == 0)
+	{
+		sim_advance(value);
+	}
+	else if (strcmp(p_command, "expect-reports") == 0)
+	{
+		if (sim.report_count != value)
+		{
+			printf("%s:%d: %u ms: expected %u keys, host has had %u\n", p_path, line_num, sim.time, value, sim.report_count);
+			(*p_failures)++;
+		}
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+
+int sim_run_script(char const * p_path)
+{
+	char line[SCRIPT_MAX_LINE];
+	typist_timing_t timing = TYPIST_DEFAULT_TIMING;
+	int failures = 0;
+	int line_num = 0;
+	FILE * p_file = fopen(p_path, "r");
+
+	if (p_file == NULL)
+	{
+		perror(p_path);
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), p_file) != NULL)
+	{
+		line_num++;
+		line[strcspn(line, "\r\n")] = '\0';
+		if (!run_line(line, &timing, &failures, p_path, line_num))
+		{
+			printf("%s:%d: bad command\n", p_path, line_num);
+			failures++;
+		}
+	}
+
+	fclose(p_file);
+	return failures;
+}
@@ -0,0 +1,22 @@
+// Host stand-in for the SEGGER RTT header, there is no debugger so everything written is taken and lost
+#ifndef SEGGER_RTT_H
+#define SEGGER_RTT_H
+
+#define SEGGER_RTT_MODE_NO_BLOCK_SKIP         0
+#define SEGGER_RTT_MODE_NO_BLOCK_TRIM         1
+#define SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL    2
+
+static inline int SEGGER_RTT_ConfigUpBuffer(unsigned buffer_index, const char * p_name, void * p_buffer,
+											unsigned buffer_size, unsigned flags)
+{
+	(void)buffer_index; (void)p_name; (void)p_buffer; (void)buffer_size; (void)flags;
+	return 0;
+}
+
+static inline unsigned SEGGER_RTT_Write(unsigned buffer_index, const void * p_buffer, unsigned num_bytes)
+{
+	(void)buffer_index; (void)p_buffer;
+	return num_bytes;
+}
+
+#endif // SEGGER_RTT_H
@@ -0,0 +1,25 @@
+// Host stand-in for the nRF SDK header, errors stop the simulation
+#ifndef APP_ERROR_H__
+#define APP_ERROR_H__
+
+#include <stdint.h>
+
+typedef uint32_t ret_code_t;
+
+#include "nrf_error.h"
+
+void sim_error(ret_code_t err_code, char const * p_file, uint32_t line);
+
+#define APP_ERROR_CHECK(err_code)                               \
+	do                                                          \
+	{                                                           \
+		ret_code_t local_err_code = (err_code);                 \
+		if (local_err_code != NRF_SUCCESS)                      \
+		{                                                       \
+			sim_error(local_err_code, __FILE__, __LINE__);      \
+		}                                                       \
+	} while (0)
+
+#define APP_ERROR_HANDLER(err_code)   sim_error((err_code), __FILE__, __LINE__)
+
+#endif // APP_ERROR_H__
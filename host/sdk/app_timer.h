@@ -0,0 +1,12 @@
+// Host stand-in for the app_timer header, the RTC counter is worked out from the virtual time (sim.c)
+#ifndef APP_TIMER_H__
+#define APP_TIMER_H__
+
+#include <stdint.h>
+
+#define APP_TIMER_CLOCK_FREQ            32768
+#define APP_TIMER_CONFIG_RTC_FREQUENCY  1             // as sdk_config.h, the counter runs at 16384 Hz
+
+uint32_t app_timer_cnt_get(void);
+
+#endif // APP_TIMER_H__
@@ -0,0 +1,9 @@
+// Host stand-in for the app_util_platform header, the simulation has no interrupts to hold off
+#ifndef APP_UTIL_PLATFORM_H__
+#define APP_UTIL_PLATFORM_H__
+
+// as the SDK, the region is a block
+#define CRITICAL_REGION_ENTER()   {
+#define CRITICAL_REGION_EXIT()    }
+
+#endif // APP_UTIL_PLATFORM_H__
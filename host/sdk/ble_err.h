@@ -0,0 +1,9 @@
+// Host stand-in for the nRF SDK header
+#ifndef BLE_ERR_H__
+#define BLE_ERR_H__
+
+#include "nrf_error.h"
+
+#define BLE_ERROR_GATTS_SYS_ATTR_MISSING    0x3401
+
+#endif // BLE_ERR_H__
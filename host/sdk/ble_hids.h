@@ -0,0 +1,19 @@
+// Host stand-in for the nRF SDK HID service, input reports go to the fake SoftDevice in
+// host/fake_softdevice.c
+#ifndef BLE_HIDS_H__
+#define BLE_HIDS_H__
+
+#include <stdint.h>
+
+#define BLE_CONN_HANDLE_INVALID   0xFFFF
+
+typedef struct
+{
+	uint8_t instance;
+} ble_hids_t;
+
+uint32_t ble_hids_inp_rep_send(ble_hids_t * p_hids, uint8_t rep_index, uint16_t len, uint8_t * p_data, uint16_t conn_handle);
+
+uint32_t ble_hids_boot_kb_inp_rep_send(ble_hids_t * p_hids, uint16_t len, uint8_t * p_data, uint16_t conn_handle);
+
+#endif // BLE_HIDS_H__
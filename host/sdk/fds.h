@@ -0,0 +1,53 @@
+// Host stand-in for the nRF SDK flash data storage, there is never a record in flash so the
+// default macros are always used
+#ifndef FDS_H__
+#define FDS_H__
+
+#include <stdint.h>
+#include "app_error.h"
+
+#define FDS_ERR_NOT_FOUND         0x860A
+#define FDS_ERR_NO_SPACE_IN_FLASH 0x860E
+
+typedef struct { uint32_t record_id; } fds_record_desc_t;
+typedef struct { uint32_t page; uint32_t p_addr; } fds_find_token_t;
+typedef struct { uint16_t record_key; uint16_t length_words; } fds_header_t;
+typedef struct { fds_header_t const * p_header; void const * p_data; } fds_flash_record_t;
+
+typedef struct
+{
+	uint16_t file_id;
+	uint16_t key;
+	struct
+	{
+		void const * p_data;
+		uint32_t length_words;
+	} data;
+} fds_record_t;
+
+typedef enum { FDS_EVT_INIT, FDS_EVT_WRITE, FDS_EVT_UPDATE, FDS_EVT_DEL_RECORD, FDS_EVT_DEL_FILE, FDS_EVT_GC } fds_evt_id_t;
+
+typedef struct
+{
+	fds_evt_id_t id;
+	ret_code_t result;
+	struct { uint16_t file_id; } write;
+	struct { uint16_t file_id; } del;
+} fds_evt_t;
+
+typedef void (*fds_cb_t)(fds_evt_t const * p_evt);
+
+static inline ret_code_t fds_register(fds_cb_t cb) { (void)cb; return NRF_SUCCESS; }
+static inline ret_code_t fds_record_find(uint16_t file_id, uint16_t key, fds_record_desc_t * p_desc, fds_find_token_t * p_token)
+{
+	(void)file_id; (void)key; (void)p_desc; (void)p_token;
+	return FDS_ERR_NOT_FOUND;
+}
+static inline ret_code_t fds_record_open(fds_record_desc_t * p_desc, fds_flash_record_t * p_record) { (void)p_desc; (void)p_record; return FDS_ERR_NOT_FOUND; }
+static inline ret_code_t fds_record_close(fds_record_desc_t * p_desc) { (void)p_desc; return NRF_SUCCESS; }
+static inline ret_code_t fds_record_write(fds_record_desc_t * p_desc, fds_record_t const * p_record) { (void)p_desc; (void)p_record; return FDS_ERR_NO_SPACE_IN_FLASH; }
+static inline ret_code_t fds_record_update(fds_record_desc_t * p_desc, fds_record_t const * p_record) { (void)p_desc; (void)p_record; return FDS_ERR_NO_SPACE_IN_FLASH; }
+static inline ret_code_t fds_record_delete(fds_record_desc_t * p_desc) { (void)p_desc; return NRF_SUCCESS; }
+static inline ret_code_t fds_gc(void) { return NRF_SUCCESS; }
+
+#endif // FDS_H__
@@ -0,0 +1,18 @@
+// Host stand-in for the nRF SDK header, only what the keyboard sources use
+#ifndef NORDIC_COMMON_H__
+#define NORDIC_COMMON_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MIN(a, b)                 ((a) < (b) ? (a) : (b))
+#define MAX(a, b)                 ((a) < (b) ? (b) : (a))
+#define ARRAY_SIZE(arr)           (sizeof(arr) / sizeof((arr)[0]))
+
+#define UNUSED_PARAMETER(x)       ((void)(x))
+#define UNUSED_VARIABLE(x)        ((void)(x))
+#define UNUSED_RETURN_VALUE(x)    ((void)(x))
+
+#define STATIC_ASSERT(expr)       _Static_assert(expr, #expr)
+
+#endif // NORDIC_COMMON_H__
@@ -0,0 +1,8 @@
+// Host stand-in for the nRF SDK header
+#ifndef NRF_H
+#define NRF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#endif // NRF_H
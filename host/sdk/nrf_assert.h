@@ -0,0 +1,9 @@
+// Host stand-in for the nRF SDK header
+#ifndef NRF_ASSERT_H_
+#define NRF_ASSERT_H_
+
+#include <assert.h>
+
+#define ASSERT(expr)              assert(expr)
+
+#endif // NRF_ASSERT_H_
@@ -0,0 +1,15 @@
+// Host stand-in for the nRF SDK header, the error codes the keyboard uses
+#ifndef NRF_ERROR_H__
+#define NRF_ERROR_H__
+
+#define NRF_SUCCESS                     0
+#define NRF_ERROR_INTERNAL              3
+#define NRF_ERROR_NO_MEM                4
+#define NRF_ERROR_NOT_FOUND             5
+#define NRF_ERROR_INVALID_PARAM         7
+#define NRF_ERROR_INVALID_STATE         8
+#define NRF_ERROR_INVALID_LENGTH        9
+#define NRF_ERROR_BUSY                  17
+#define NRF_ERROR_RESOURCES             19
+
+#endif // NRF_ERROR_H__
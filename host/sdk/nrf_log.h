@@ -0,0 +1,20 @@
+// Host stand-in for the nRF SDK logger, log lines are printed with the virtual time when the
+// simulation is verbose
+#ifndef NRF_LOG_H_
+#define NRF_LOG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+void sim_log(char const * p_format, ...);
+
+#define NRF_LOG_ERROR(...)        sim_log(__VA_ARGS__)
+#define NRF_LOG_WARNING(...)      sim_log(__VA_ARGS__)
+#define NRF_LOG_INFO(...)         sim_log(__VA_ARGS__)
+#define NRF_LOG_DEBUG(...)        sim_log(__VA_ARGS__)
+#define NRF_LOG_HEXDUMP_INFO(p_data, len)   ((void)(p_data), (void)(len))
+#define NRF_LOG_HEXDUMP_DEBUG(p_data, len)  ((void)(p_data), (void)(len))
+#define NRF_LOG_FLUSH()           ((void)0)
+#define NRF_LOG_PROCESS()         (false)
+
+#endif // NRF_LOG_H_
@@ -0,0 +1,7 @@
+// Host stand-in for the nRF SDK header, the logger is in nrf_log.h
+#ifndef NRF_LOG_CTRL_H
+#define NRF_LOG_CTRL_H
+
+#include "nrf_log.h"
+
+#endif // NRF_LOG_CTRL_H
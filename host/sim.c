@@ -0,0 +1,356 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nordic_common.h"
+#include "app_error.h"
+#include "app_timer.h"
+
+#include "sim.h"
+#include "usb_hid_keys.h"
+
+#define SIM_BATTERY_LEVEL         87            // battery level reported (in %)
+#define SIM_CTRL_MODIFIERS        (KEY_MOD_LCTRL | KEY_MOD_RCTRL)
+#define SIM_SHIFT_MODIFIERS       (KEY_MOD_LSHIFT | KEY_MOD_RSHIFT)
+
+sim_state_t sim;
+
+// Virtual time the key repeat timer fires, 0 when it isn't running
+static uint32_t key_repeat_due = 0;
+
+// US layout characters from KEY_1 to KEY_SLASH, without and with shift (0 for keys that don't type)
+static const char key_chars[2][KEY_SLASH - KEY_1 + 1] =
+{
+	{ '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '\n', 0, 0, '\t', ' ', '-', '=', '[', ']', '\\', 0, ';', '\'', '`', ',', '.', '/' },
+	{ '!', '@', '#', '$', '%', '^', '&', '*', '(', ')', '\n', 0, 0, '\t', ' ', '_', '+', '{', '}', '|', 0, ':', '"', '~', '<', '>', '?' },
+};
+
+
+// Keyboard hardware
+
+bool board_key_down(enum board_key key)
+{
+	return sim.keys[key];
+}
+
+
+void sleep_mode_enter(bool all_btns_wake)
+{
+	UNUSED_PARAMETER(all_btns_wake);
+	sim_log("Sleep");
+	sim.asleep = true;
+}
+
+
+void start_pair_mode(void)
+{
+}
+
+
+void toggle_led(void)
+{
+}
+
+
+void set_device_state(enum device_state state)
+{
+	sim_log("Device State: %d", state);
+}
+
+
+// Timers
+
+void extend_inactive_timer()
+{
+}
+
+
+void start_led_flash_timer(bool fast)
+{
+	UNUSED_PARAMETER(fast);
+}
+
+
+void stop_led_flash_timer(void)
+{
+}
+
+
+void start_key_repeat_timer(uint32_t time)
+{
+	key_repeat_due = sim.time + MAX(time, 1);
+}
+
+
+void stop_key_repeat_timer(void)
+{
+	key_repeat_due = 0;
+}
+
+
+// RTC counter at the virtual time, a 24 bit count as on the device
+uint32_t app_timer_cnt_get(void)
+{
+	return (((uint64_t)sim.time * (APP_TIMER_CLOCK_FREQ / (APP_TIMER_CONFIG_RTC_FREQUENCY + 1))) / 1000) & 0xFFFFFF;
+}
+
+
+// Battery
+
+uint8_t get_battery_level(void)
+{
+	return SIM_BATTERY_LEVEL;
+}
+
+
+// Logging
+
+void sim_log(char const * p_format, ...)
+{
+	va_list args;
+
+	if (!sim.verbose)
+	{
+		return;
+	}
+
+	printf("%8u  ", sim.time);
+	va_start(args, p_format);
+	vprintf(p_format, args);
+	va_end(args);
+	printf("\n");
+}
+
+
+void sim_error(ret_code_t err_code, char const * p_file, uint32_t line)
+{
+	fprintf(stderr, "%u ms: error 0x%x at %s:%u\n", sim.time, err_code, p_file, line);
+	exit(2);
+}
+
+
+// Host text
+
+static bool word_char(uint16_t pos)
+{
+	char c = sim.text[pos];
+	return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9'));
+}
+
+
+// position of the start of the word before the cursor, as ctrl + left on most hosts
+static uint16_t word_start(void)
+{
+	uint16_t pos = sim.cursor;
+
+	while ((pos > 0) && !word_char(pos - 1))
+	{
+		pos--;
+	}
+	while ((pos > 0) && word_char(pos - 1))
+	{
+		pos--;
+	}
+	return pos;
+}
+
+
+static uint16_t word_end(void)
+{
+	uint16_t pos = sim.cursor;
+
+	while ((pos < sim.text_len) && !word_char(pos))
+	{
+		pos++;
+	}
+	while ((pos < sim.text_len) && word_char(pos))
+	{
+		pos++;
+	}
+	return pos;
+}
+
+
+static void text_insert(char c)
+{
+	if (sim.text_len >= SIM_MAX_TEXT)
+	{
+		return;
+	}
+	memmove(&sim.text[sim.cursor + 1], &sim.text[sim.cursor], sim.text_len - sim.cursor);
+	memmove(&sim.text_time[sim.cursor + 1], &sim.text_time[sim.cursor], (sim.text_len - sim.cursor) * sizeof(uint32_t));
+	sim.text_time[sim.cursor] = sim.time;
+	sim.text[sim.cursor++] = c;
+	sim.text[++sim.text_len] = '\0';
+}
+
+
+static void text_delete_to_cursor(uint16_t pos)
+{
+	memmove(&sim.text[pos], &sim.text[sim.cursor], sim.text_len - sim.cursor);
+	memmove(&sim.text_time[pos], &sim.text_time[sim.cursor], (sim.text_len - sim.cursor) * sizeof(uint32_t));
+	sim.text_len -= sim.cursor - pos;
+	sim.text[sim.text_len] = '\0';
+	sim.cursor = pos;
+}
+
+
+// character typed by a key on a US layout, 0 if it doesn't type one
+static char key_char(uint8_t modifiers, uint8_t key)
+{
+	bool shift = (modifiers & SIM_SHIFT_MODIFIERS) != 0;
+
+	if ((key >= KEY_A) && (key <= KEY_Z))
+	{
+		return (shift ? 'A' : 'a') + (key - KEY_A);
+	}
+	if ((key >= KEY_1) && (key <= KEY_SLASH))
+	{
+		return key_chars[shift][key - KEY_1];
+	}
+	return 0;
+}
+
+
+bool sim_char_key(char c, uint8_t * p_key, uint8_t * p_modifiers)
+{
+	for (uint8_t key = KEY_A; key <= KEY_SLASH; key++)
+	{
+		for (uint8_t shift = 0; shift < 2; shift++)
+		{
+			if (key_char(shift ? KEY_MOD_LSHIFT : 0, key) == c)
+			{
+				*p_key = key;
+				*p_modifiers = shift ? KEY_MOD_LSHIFT : 0;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+
+void sim_host_key(uint8_t modifiers, uint8_t key)
+{
+	bool ctrl = (modifiers & SIM_CTRL_MODIFIERS) != 0;
+	char c = key_char(modifiers, key);
+
+	if (sim.report_count < SIM_MAX_REPORTS)
+	{
+		sim_report_t * p_report = &sim.reports[sim.report_count];
+		p_report->time = sim.time;
+		p_report->modifiers = modifiers;
+		p_report->key = key;
+	}
+	sim.report_count++;
+
+	if (sim.verbose)
+	{
+		printf("%8u  Host Key: 0x%02x / 0x%02x '%c'\n", sim.time, key, modifiers, ((c >= ' ') && !ctrl) ? c : ' ');
+	}
+
+	switch (key)
+	{
+	    case KEY_BACKSPACE:
+			if (sim.cursor > 0)
+			{
+				text_delete_to_cursor(ctrl ? word_start() : sim.cursor - 1);
+			}
+			break;
+	    case KEY_LEFT:
+			sim.cursor = ctrl ? word_start() : ((sim.cursor > 0) ? sim.cursor - 1 : 0);
+			break;
+	    case KEY_RIGHT:
+			sim.cursor = ctrl ? word_end() : MIN(sim.cursor + 1, sim.text_len);
+			break;
+	    case KEY_HOME:
+			sim.cursor = 0;
+			break;
+	    case KEY_END:
+			sim.cursor = sim.text_len;
+			break;
+	    default:
+			// shortcuts (ctrl, alt or gui with a key) don't type anything
+			if ((c != 0) && ((modifiers & ~SIM_SHIFT_MODIFIERS) == 0))
+			{
+				text_insert(c);
+			}
+			break;
+	}
+}
+
+
+// Virtual clock
+
+void sim_init(bool verbose)
+{
+	memset(&sim, 0, sizeof(sim));
+	sim.verbose = verbose;
+	sim.connected = true;
+	key_repeat_due = 0;
+
+	keyboard_init();
+	sim_link_init();
+}
+
+
+void sim_set_key(enum board_key key, bool down)
+{
+	if (!down && sim.keys[key] && (key != POWER_KEY))
+	{
+		sim.last_release_time = sim.time;
+	}
+	sim.keys[key] = down;
+}
+
+
+void sim_set_connected(bool connected)
+{
+	sim.connected = connected;
+	sim_link_set_connected(connected);
+	sim_log("Link: %s", connected ? "connected" : "disconnected");
+}
+
+
+// run the timers and poll for one ms of virtual time
+static void sim_tick(void)
+{
+	sim.time++;
+
+	if ((key_repeat_due != 0) && (sim.time >= key_repeat_due))
+	{
+		key_repeat_due = 0;
+		key_repeat();
+	}
+
+	if ((sim.time % SIM_POLL_INTERVAL) == 0)
+	{
+		poll_keys();
+	}
+
+	sim_link_advance(sim.time);
+
+	// log messages are recorded as events and formatted later, as the device's idle loop does
+	if (sim.verbose)
+	{
+		while (event_log_process())
+		{
+		}
+	}
+}
+
+
+void sim_advance(uint32_t ms)
+{
+	sim_advance_to(sim.time + ms);
+}
+
+
+void sim_advance_to(uint32_t time)
+{
+	while (sim.time < time)
+	{
+		sim_tick();
+	}
+}
@@ -0,0 +1,135 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+
+/*
+ * Host simulation of the keyboard. The decoder (keyboard.c and the modules it uses) is run
+ * against a virtual clock: poll_keys() is called every SIM_POLL_INTERVAL ms and the key repeat
+ * timer fires at its exact virtual time, so a run only depends on the button timeline it is given.
+ *
+ * Keys reaching the host are applied to a simple text editor model so that the text typed can be
+ * checked, and each one is recorded with the time it arrived.
+ */
+
+#define SIM_POLL_INTERVAL         10            // ms between calls to poll_keys(), as BTN_POLL_INTERVAL
+#define SIM_MAX_TEXT              1024          // longest host text kept
+#define SIM_MAX_REPORTS           4096          // keys arriving at the host that are recorded
+
+// A key that arrived at the host
+typedef struct
+{
+	uint32_t time;                // virtual time it arrived (in ms)
+	uint8_t modifiers;
+	uint8_t key;
+} sim_report_t;
+
+// Simulation state that can be read back after a run
+typedef struct
+{
+	uint32_t time;                // virtual time (in ms)
+	uint32_t last_release_time;   // virtual time of the last button release
+	bool keys[3];                 // button states, indexed by enum board_key
+	bool connected;
+	bool asleep;                  // the power key switched the keyboard off
+	bool verbose;                 // print log lines and keys as they happen
+	char text[SIM_MAX_TEXT + 1];  // text on the host
+	uint32_t text_time[SIM_MAX_TEXT];  // virtual time each character of the text arrived
+	uint16_t text_len;
+	uint16_t cursor;
+	sim_report_t reports[SIM_MAX_REPORTS];
+	uint32_t report_count;        // keys arrived, can be more than SIM_MAX_REPORTS
+} sim_state_t;
+
+extern sim_state_t sim;
+
+
+/**@brief Function for starting a new simulation, must be called once before the first run.
+ *
+ * @details The keyboard modules keep their own state, so each simulation runs in its own process.
+ */
+void sim_init(bool verbose);
+
+// press or release a button at the current virtual time
+void sim_set_key(enum board_key key, bool down);
+
+// run the keyboard until the virtual time has advanced by a number of ms
+void sim_advance(uint32_t ms);
+
+// run the keyboard until a virtual time, if it hasn't already passed
+void sim_advance_to(uint32_t time);
+
+void sim_set_connected(bool connected);
+
+/**@brief Function for a key arriving at the host, called by the link.
+ *
+ * @details Applies the key to the host text and records it.
+ */
+void sim_host_key(uint8_t modifiers, uint8_t key);
+
+// find the key (and shift) that types a character on the host, returns false if there isn't one
+bool sim_char_key(char c, uint8_t * p_key, uint8_t * p_modifiers);
+
+// Link, the report sink used by the keyboard (sim_link.c, or hid_reports.c on the fake SoftDevice in fake_softdevice.c)
+
+void sim_link_init(void);
+
+void sim_link_advance(uint32_t time);
+
+void sim_link_set_connected(bool connected);
+
+
+// Press traces (recorded by trace.c)
+
+#define SIM_MAX_TRACE             65536         // largest trace file read (in bytes)
+
+// A trace found in a dump
+typedef struct
+{
+	uint8_t start_state;          // button readings before the first edge, a bit for each enum board_key
+	uint32_t start_time;          // poll count the first edge's delta is from
+	uint16_t len;                 // bytes of edges
+	uint8_t const * p_edges;
+} sim_trace_t;
+
+// A change in the reading of a button
+typedef struct
+{
+	uint8_t key;                  // enum board_key
+	bool down;
+	uint32_t delta;               // poll cycles since the last edge
+} sim_trace_edge_t;
+
+// read a trace dump into a buffer, returns the number of bytes read (0 if it can't be read)
+uint32_t sim_trace_load(char const * p_path, uint8_t * p_data, uint32_t size);
+
+// find the trace in a dump, which can have other output before it
+bool sim_trace_parse(uint8_t const * p_data, uint32_t len, sim_trace_t * p_trace);
+
+// decode the edge at a position in a trace and move the position on, returns false at the end
+bool sim_trace_next(sim_trace_t const * p_trace, uint32_t * p_pos, sim_trace_edge_t * p_edge);
+
+/**@brief Function for replaying a trace from the current virtual time.
+ *
+ * @details Each edge is applied just before the poll cycle it was read in (counted from the poll
+ *          cycle the replay starts at), the keyboard is left at the time of the last edge.
+ *
+ * @return      false if the trace is corrupt.
+ */
+bool sim_replay_trace(sim_trace_t const * p_trace);
+
+
+// Scripts
+
+/**@brief Function for running a press timeline script.
+ *
+ * @param[in]   p_path    Script file.
+ *
+ * @return      Number of failed expectations, or -1 if the script can't be read.
+ */
+int sim_run_script(char const * p_path);
+
+#endif // SIM_H
@@ -0,0 +1,100 @@
+#include <stdio.h>
+
+#include "nordic_common.h"
+
+#include "sim.h"
+
+/*
+ * Ideal link for the simulation, in place of bluetooth.c. Keys reach the host as soon as they are
+ * sent and nothing is lost.
+ */
+
+// The low power connection parameters are in use, each connection starts with the normal ones
+static bool low_power_mode = false;
+
+
+void sim_link_init(void)
+{
+}
+
+
+void sim_link_advance(uint32_t time)
+{
+	UNUSED_PARAMETER(time);
+}
+
+
+void sim_link_set_connected(bool connected)
+{
+	if (connected)
+	{
+		low_power_mode = false;
+	}
+}
+
+
+bool bluetooth_is_connected(void)
+{
+	return sim.connected;
+}
+
+
+bool bluetooth_caps_lock_on(void)
+{
+	return false;
+}
+
+
+void send_key(uint8_t key, uint8_t modifiers)
+{
+	sim_host_key(modifiers, key);
+}
+
+
+void send_keys(uint8_t const * p_keys, uint8_t count)
+{
+	for (uint8_t i = 0; i < count; i++)
+	{
+		sim_host_key(p_keys[i * 2], p_keys[(i * 2) + 1]);
+	}
+}
+
+
+void send_keys_packed(uint8_t const * p_keys, uint8_t count)
+{
+	send_keys(p_keys, count);
+}
+
+
+// the host's own key repeat isn't simulated, a held key types once
+void send_key_hold(uint8_t key, uint8_t modifiers)
+{
+	sim_host_key(modifiers, key);
+}
+
+
+void send_key_release(void)
+{
+}
+
+
+void bluetooth_pair(void)
+{
+	sim_log("Pair");
+}
+
+
+void bluetooth_next_peer(void)
+{
+	sim_log("Next Peer");
+}
+
+
+void bluetooth_toggle_power_profile(void)
+{
+	if (sim.connected)
+	{
+		low_power_mode = !low_power_mode;
+		sim_log("Power Profile: %d", low_power_mode);
+	}
+}
@@ -0,0 +1,629 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "nordic_common.h"
+
+#include "sim.h"
+
+/*
+ * Decoder timing sweep over a corpus of press traces. Each trace is replayed through the decoder
+ * with each setting of the timing parameters, and the host text is compared with the text that
+ * was meant (a .txt file next to each .trace file). The replays are run in parallel, one process
+ * each, on all of the cores.
+ *
+ * usage: sweep [-j jobs] [-a] [-p name=value,...]... user-dir...
+ *
+ *   -j    replays run at once (default the number of cores)
+ *   -a    adaptive search from the default timing instead of trying every setting in the grid
+ *   -p    values to try for a parameter (advance, hold, and lockout-l, release-l, lockout-r or release-r
+ *         for the debounce of the left and right buttons, all in poll cycles)
+ *
+ * Each directory holds the traces of one user, and a setting is recommended for each. Settings are
+ * ranked by the characters wrong (edit distance from the text meant), then by the mean time from
+ * the release that ends a character to it reaching the host, and settings that do equally well by
+ * the fewest parameters changed from the decoder's own timing.
+ */
+
+#define SWEEP_MAX_USERS           16
+#define SWEEP_MAX_TRACES          64            // most traces for each user
+#define SWEEP_MAX_VALUES          16            // most values tried for each parameter
+#define SWEEP_MAX_SETTINGS        4096
+#define SWEEP_MAX_EDGES           SIM_MAX_TRACE
+#define SWEEP_SETTLE_TIME         3000          // time the keyboard is run for after the last edge (in ms)
+#define SWEEP_TOP_COUNT           5             // best settings listed for each user
+
+// Timing parameters that can be swept
+enum sweep_param { ADVANCE, HOLD, LEFT_LOCKOUT, LEFT_RELEASE, RIGHT_LOCKOUT, RIGHT_RELEASE, PARAM_COUNT };
+
+static char const * const param_names[PARAM_COUNT] =
+{
+	"advance", "hold", "lockout-l", "release-l", "lockout-r", "release-r"
+};
+
+typedef struct
+{
+	uint8_t count;
+	uint16_t values[SWEEP_MAX_VALUES];
+} param_values_t;
+
+static param_values_t param_values[PARAM_COUNT] =
+{
+	{ 6, { 12, 16, 20, 24, 28, 32 } },
+	{ 3, { 70, 100, 130 } },
+	{ 3, { 2, 3, 4 } },
+	{ 3, { 1, 2, 3 } },
+	{ 3, { 2, 3, 4 } },
+	{ 3, { 1, 2, 3 } },
+};
+
+// A setting, the index into param_values of each parameter
+typedef struct
+{
+	uint8_t index[PARAM_COUNT];
+} setting_t;
+
+typedef struct
+{
+	char path[256];
+	uint8_t * p_data;
+	uint32_t len;
+	char * p_text;                // text meant
+	uint16_t text_len;
+} trace_file_t;
+
+typedef struct
+{
+	char const * p_name;
+	trace_file_t traces[SWEEP_MAX_TRACES];
+	uint16_t trace_count;
+	uint32_t char_count;
+} user_t;
+
+// Result of one replay, written by the process that ran it
+typedef struct
+{
+	bool done;
+	uint32_t errors;              // edit distance of the host text from the text meant
+	uint64_t latency_total;       // ms, over the characters on the host
+	uint32_t latency_count;
+	uint32_t presses;             // presses accepted by the debouncer
+} replay_result_t;
+
+// Results of a setting over all of a user's traces
+typedef struct
+{
+	setting_t setting;
+	uint32_t errors;
+	uint32_t chars;
+	double latency;               // mean (in ms)
+	double presses;               // presses per character typed correctly
+} setting_result_t;
+
+static user_t users[SWEEP_MAX_USERS];
+static uint16_t user_count = 0;
+static uint32_t job_limit = 1;
+
+static setting_result_t results[SWEEP_MAX_SETTINGS];
+static setting_t defaults;                       // the decoder's own timing
+
+
+static char * read_file(char const * p_path, uint32_t * p_len)
+{
+	FILE * p_file = fopen(p_path, "rb");
+	char * p_data;
+	long len;
+
+	if (p_file == NULL)
+	{
+		return NULL;
+	}
+	fseek(p_file, 0, SEEK_END);
+	len = ftell(p_file);
+	fseek(p_file, 0, SEEK_SET);
+	p_data = malloc(len + 1);
+	len = fread(p_data, 1, len, p_file);
+	p_data[len] = '\0';
+	fclose(p_file);
+	*p_len = len;
+	return p_data;
+}
+
+
+// load the traces of a user, each .trace file with the .txt file of the text meant
+static bool load_user(char const * p_dir, user_t * p_user)
+{
+	DIR * p_d = opendir(p_dir);
+	struct dirent * p_entry;
+
+	if (p_d == NULL)
+	{
+		perror(p_dir);
+		return false;
+	}
+
+	p_user->p_name = p_dir;
+	while (((p_entry = readdir(p_d)) != NULL) && (p_user->trace_count < SWEEP_MAX_TRACES))
+	{
+		trace_file_t * p_trace = &p_user->traces[p_user->trace_count];
+		size_t name_len = strlen(p_entry->d_name);
+		char text_path[sizeof(p_trace->path)];
+		uint32_t text_len;
+		sim_trace_t parsed;
+
+		if ((name_len < 7) || (strcmp(&p_entry->d_name[name_len - 6], ".trace") != 0))
+		{
+			continue;
+		}
+
+		snprintf(p_trace->path, sizeof(p_trace->path), "%s/%s", p_dir, p_entry->d_name);
+		snprintf(text_path, sizeof(text_path), "%s/%.*s.txt", p_dir, (int)(name_len - 6), p_entry->d_name);
+		p_trace->p_data = (uint8_t *)read_file(p_trace->path, &p_trace->len);
+		p_trace->p_text = read_file(text_path, &text_len);
+		if ((p_trace->p_data == NULL) || !sim_trace_parse(p_trace->p_data, p_trace->len, &parsed))
+		{
+			fprintf(stderr, "%s: no trace found, skipped\n", p_trace->path);
+			continue;
+		}
+		if (p_trace->p_text == NULL)
+		{
+			fprintf(stderr, "%s: no text, skipped\n", text_path);
+			continue;
+		}
+		while ((text_len > 0) && (p_trace->p_text[text_len - 1] == '\n'))
+		{
+			text_len--;
+		}
+		p_trace->p_text[text_len] = '\0';
+		p_trace->text_len = text_len;
+		p_user->char_count += text_len;
+		p_user->trace_count++;
+	}
+	closedir(p_d);
+	return p_user->trace_count > 0;
+}
+
+
+static void setting_timing(setting_t const * p_setting, keyboard_timing_t * p_timing)
+{
+	p_timing->advance_time = param_values[ADVANCE].values[p_setting->index[ADVANCE]];
+	p_timing->key_hold_time = param_values[HOLD].values[p_setting->index[HOLD]];
+	p_timing->left_press_lockout = param_values[LEFT_LOCKOUT].values[p_setting->index[LEFT_LOCKOUT]];
+	p_timing->left_release_samples = param_values[LEFT_RELEASE].values[p_setting->index[LEFT_RELEASE]];
+	p_timing->right_press_lockout = param_values[RIGHT_LOCKOUT].values[p_setting->index[RIGHT_LOCKOUT]];
+	p_timing->right_release_samples = param_values[RIGHT_RELEASE].values[p_setting->index[RIGHT_RELEASE]];
+}
+
+
+static void setting_name(setting_t const * p_setting, char * p_buf, size_t size)
+{
+	int len = 0;
+
+	for (uint8_t i = 0; i < PARAM_COUNT; i++)
+	{
+		len += snprintf(&p_buf[len], size - len, "%s%s %u", (i > 0) ? " " : "", param_names[i],
+						param_values[i].values[p_setting->index[i]]);
+	}
+}
+
+
+// case insensitive edit distance, auto capitalisation isn't an error
+static uint32_t edit_distance(char const * p_a, uint32_t a_len, char const * p_b, uint32_t b_len)
+{
+	static uint32_t row[2][SIM_MAX_TEXT + 2];
+
+	for (uint32_t j = 0; j <= b_len; j++)
+	{
+		row[0][j] = j;
+	}
+	for (uint32_t i = 1; i <= a_len; i++)
+	{
+		uint32_t * p_row = row[i & 1];
+		uint32_t const * p_last = row[(i - 1) & 1];
+
+		p_row[0] = i;
+		for (uint32_t j = 1; j <= b_len; j++)
+		{
+			uint32_t cost = (tolower((unsigned char)p_a[i - 1]) == tolower((unsigned char)p_b[j - 1])) ? 0 : 1;
+			p_row[j] = MIN(MIN(p_last[j] + 1, p_row[j - 1] + 1), p_last[j - 1] + cost);
+		}
+	}
+	return row[a_len & 1][b_len];
+}
+
+
+// find the last of the sorted release times at or before a time
+static bool last_release(uint32_t const * p_releases, uint32_t count, uint32_t time, uint32_t * p_release)
+{
+	uint32_t low = 0;
+	uint32_t high = count;
+
+	while (low < high)
+	{
+		uint32_t mid = (low + high) / 2;
+		if (p_releases[mid] <= time)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+	if (low == 0)
+	{
+		return false;
+	}
+	*p_release = p_releases[low - 1];
+	return true;
+}
+
+
+// replay a trace with a setting, run in its own process
+static void replay(trace_file_t const * p_file, setting_t const * p_setting, replay_result_t * p_result)
+{
+	static uint32_t releases[SWEEP_MAX_EDGES];
+	uint32_t release_count = 0;
+	keyboard_timing_t timing;
+	sim_trace_t trace;
+	sim_trace_edge_t edge;
+	uint32_t pos = 0;
+	uint32_t poll = 0;
+
+	UNUSED_RETURN_VALUE(sim_trace_parse(p_file->p_data, p_file->len, &trace));
+
+	// the releases that can end a character, at the time they are replayed
+	while (sim_trace_next(&trace, &pos, &edge))
+	{
+		poll += edge.delta;
+		if (!edge.down && (edge.key != POWER_KEY) && (poll > 0))
+		{
+			releases[release_count++] = (poll * SIM_POLL_INTERVAL) - 1;
+		}
+	}
+
+	sim_init(false);
+	setting_timing(p_setting, &timing);
+	keyboard_set_timing(&timing);
+	UNUSED_RETURN_VALUE(sim_replay_trace(&trace));
+	sim_advance(SWEEP_SETTLE_TIME);
+
+	p_result->errors = edit_distance(sim.text, sim.text_len, p_file->p_text, p_file->text_len);
+	p_result->presses = get_press_count();
+	for (uint16_t i = 0; i < sim.text_len; i++)
+	{
+		uint32_t release;
+		if (last_release(releases, release_count, sim.text_time[i], &release))
+		{
+			p_result->latency_total += sim.text_time[i] - release;
+			p_result->latency_count++;
+		}
+	}
+	p_result->done = true;
+}
+
+
+// replay every trace of a user with each setting, spread over job_limit processes
+static void evaluate(user_t const * p_user, setting_t const * p_settings, uint32_t count)
+{
+	uint32_t job_count = count * p_user->trace_count;
+	size_t size = job_count * sizeof(replay_result_t);
+	replay_result_t * p_replays = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	uint32_t running = 0;
+
+	if (p_replays == MAP_FAILED)
+	{
+		perror("mmap");
+		exit(2);
+	}
+	memset(p_replays, 0, size);
+
+	fflush(stdout);
+	for (uint32_t job = 0; job < job_count; job++)
+	{
+		if (running >= job_limit)
+		{
+			UNUSED_RETURN_VALUE(wait(NULL));
+			running--;
+		}
+		if (fork() == 0)
+		{
+			replay(&p_user->traces[job % p_user->trace_count], &p_settings[job / p_user->trace_count], &p_replays[job]);
+			_exit(0);
+		}
+		running++;
+	}
+	while (running > 0)
+	{
+		UNUSED_RETURN_VALUE(wait(NULL));
+		running--;
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		setting_result_t * p_result = &results[i];
+		uint64_t latency_total = 0;
+		uint32_t latency_count = 0;
+		uint32_t presses = 0;
+
+		memset(p_result, 0, sizeof(setting_result_t));
+		p_result->setting = p_settings[i];
+		for (uint16_t t = 0; t < p_user->trace_count; t++)
+		{
+			replay_result_t const * p_replay = &p_replays[(i * p_user->trace_count) + t];
+			// a replay that failed counts every character as wrong
+			p_result->errors += p_replay->done ? p_replay->errors : p_user->traces[t].text_len;
+			latency_total += p_replay->latency_total;
+			latency_count += p_replay->latency_count;
+			presses += p_replay->presses;
+		}
+		p_result->chars = p_user->char_count;
+		p_result->latency = (latency_count > 0) ? (double)latency_total / latency_count : 0.0;
+		p_result->presses = (double)presses / MAX(p_user->char_count - MIN(p_result->errors, p_user->char_count), 1);
+	}
+
+	munmap(p_replays, size);
+}
+
+
+// number of parameters of a setting changed from the defaults
+static uint8_t changes(setting_t const * p_setting)
+{
+	uint8_t count = 0;
+
+	for (uint8_t i = 0; i < PARAM_COUNT; i++)
+	{
+		count += (p_setting->index[i] != defaults.index[i]) ? 1 : 0;
+	}
+	return count;
+}
+
+
+static int compare_results(void const * p_a, void const * p_b)
+{
+	setting_result_t const * p_ra = p_a;
+	setting_result_t const * p_rb = p_b;
+
+	if (p_ra->errors != p_rb->errors)
+	{
+		return (p_ra->errors > p_rb->errors) - (p_ra->errors < p_rb->errors);
+	}
+	if (p_ra->latency != p_rb->latency)
+	{
+		return (p_ra->latency > p_rb->latency) - (p_ra->latency < p_rb->latency);
+	}
+	return changes(&p_ra->setting) - changes(&p_rb->setting);
+}
+
+
+static bool same_setting(setting_t const * p_a, setting_t const * p_b)
+{
+	return memcmp(p_a, p_b, sizeof(setting_t)) == 0;
+}
+
+
+static void print_result(setting_result_t const * p_result, char const * p_note)
+{
+	char name[128];
+
+	setting_name(&p_result->setting, name, sizeof(name));
+	printf("  %-76s %6u %8.2f%% %8.1f %8.2f %s\n", name, p_result->errors,
+		   100.0 * (1.0 - ((double)p_result->errors / MAX(p_result->chars, 1))), p_result->latency, p_result->presses, p_note);
+}
+
+
+// the setting nearest the decoder's own timing in the values swept
+static void default_setting(setting_t * p_setting)
+{
+	keyboard_timing_t timing;
+	uint16_t defaults[PARAM_COUNT];
+
+	keyboard_get_timing(&timing);
+	defaults[ADVANCE] = timing.advance_time;
+	defaults[HOLD] = timing.key_hold_time;
+	defaults[LEFT_LOCKOUT] = timing.left_press_lockout;
+	defaults[LEFT_RELEASE] = timing.left_release_samples;
+	defaults[RIGHT_LOCKOUT] = timing.right_press_lockout;
+	defaults[RIGHT_RELEASE] = timing.right_release_samples;
+
+	for (uint8_t i = 0; i < PARAM_COUNT; i++)
+	{
+		p_setting->index[i] = 0;
+		for (uint8_t v = 1; v < param_values[i].count; v++)
+		{
+			if (abs((int)param_values[i].values[v] - defaults[i]) <
+				abs((int)param_values[i].values[p_setting->index[i]] - defaults[i]))
+			{
+				p_setting->index[i] = v;
+			}
+		}
+	}
+}
+
+
+static void grid_search(user_t const * p_user)
+{
+	static setting_t settings[SWEEP_MAX_SETTINGS];
+	uint32_t count = 1;
+	setting_result_t default_result;
+
+	for (uint8_t i = 0; i < PARAM_COUNT; i++)
+	{
+		count *= param_values[i].count;
+	}
+	if (count > SWEEP_MAX_SETTINGS)
+	{
+		fprintf(stderr, "%u settings, at most %u can be swept\n", count, SWEEP_MAX_SETTINGS);
+		exit(2);
+	}
+
+	for (uint32_t s = 0; s < count; s++)
+	{
+		uint32_t n = s;
+		for (uint8_t i = 0; i < PARAM_COUNT; i++)
+		{
+			settings[s].index[i] = n % param_values[i].count;
+			n /= param_values[i].count;
+		}
+	}
+
+	evaluate(p_user, settings, count);
+	for (uint32_t s = 0; s < count; s++)
+	{
+		if (same_setting(&results[s].setting, &defaults))
+		{
+			default_result = results[s];
+		}
+	}
+	qsort(results, count, sizeof(setting_result_t), compare_results);
+
+	print_result(&default_result, "(default)");
+	for (uint32_t s = 0; s < MIN(count, SWEEP_TOP_COUNT); s++)
+	{
+		print_result(&results[s], (s == 0) ? "(recommended)" : "");
+	}
+}
+
+
+// move one parameter at a time to the neighbouring value that does best, until none do better
+static void adaptive_search(user_t const * p_user)
+{
+	setting_t neighbours[(PARAM_COUNT * 2) + 1];
+	setting_result_t best;
+	uint32_t rounds = 0;
+
+	evaluate(p_user, &defaults, 1);
+	best = results[0];
+	print_result(&best, "(default)");
+
+	while (true)
+	{
+		uint32_t count = 0;
+		uint32_t best_index = 0;
+
+		for (uint8_t i = 0; i < PARAM_COUNT; i++)
+		{
+			for (int8_t step = -1; step <= 1; step += 2)
+			{
+				int16_t index = best.setting.index[i] + step;
+				if ((index >= 0) && (index < param_values[i].count))
+				{
+					neighbours[count] = best.setting;
+					neighbours[count].index[i] = index;
+					count++;
+				}
+			}
+		}
+
+		evaluate(p_user, neighbours, count);
+		for (uint32_t s = 1; s < count; s++)
+		{
+			if (compare_results(&results[s], &results[best_index]) < 0)
+			{
+				best_index = s;
+			}
+		}
+		rounds++;
+		if ((count == 0) || (compare_results(&results[best_index], &best) >= 0))
+		{
+			break;
+		}
+		best = results[best_index];
+	}
+
+	print_result(&best, "(recommended)");
+	printf("  %u rounds\n", rounds);
+}
+
+
+static bool parse_values(char * p_arg)
+{
+	char * p_values = strchr(p_arg, '=');
+
+	if (p_values == NULL)
+	{
+		return false;
+	}
+	*p_values++ = '\0';
+
+	for (uint8_t i = 0; i < PARAM_COUNT; i++)
+	{
+		if (strcmp(p_arg, param_names[i]) == 0)
+		{
+			param_values[i].count = 0;
+			for (char * p = strtok(p_values, ","); (p != NULL) && (param_values[i].count < SWEEP_MAX_VALUES); p = strtok(NULL, ","))
+			{
+				param_values[i].values[param_values[i].count++] = strtoul(p, NULL, 10);
+			}
+			return param_values[i].count > 0;
+		}
+	}
+	return false;
+}
+
+
+int main(int argc, char * argv[])
+{
+	bool adaptive = false;
+	int opt;
+
+	job_limit = MAX(sysconf(_SC_NPROCESSORS_ONLN), 1);
+
+	while ((opt = getopt(argc, argv, "j:ap:")) != -1)
+	{
+		switch (opt)
+		{
+		    case 'j':
+				job_limit = MAX(strtoul(optarg, NULL, 10), 1);
+				break;
+		    case 'a':
+				adaptive = true;
+				break;
+		    case 'p':
+				if (!parse_values(optarg))
+				{
+					fprintf(stderr, "-p must be advance, hold, lockout or release=value,...\n");
+					return 2;
+				}
+				break;
+		    default:
+				fprintf(stderr, "usage: sweep [-j jobs] [-a] [-p name=value,...]... user-dir...\n");
+				return 2;
+		}
+	}
+
+	for (int i = optind; (i < argc) && (user_count < SWEEP_MAX_USERS); i++)
+	{
+		if (load_user(argv[i], &users[user_count]))
+		{
+			user_count++;
+		}
+	}
+	if (user_count == 0)
+	{
+		fprintf(stderr, "no traces found\n");
+		return 2;
+	}
+
+	default_setting(&defaults);
+	for (uint16_t u = 0; u < user_count; u++)
+	{
+		printf("%s: %u traces, %u characters, %u jobs\n", users[u].p_name, users[u].trace_count, users[u].char_count, job_limit);
+		printf("  %-76s %6s %9s %8s %8s\n", "setting (poll cycles)", "wrong", "accuracy", "latency", "presses");
+		if (adaptive)
+		{
+			adaptive_search(&users[u]);
+		}
+		else
+		{
+			grid_search(&users[u]);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,358 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "nordic_common.h"
+
+#include "sim.h"
+#include "typist.h"
+
+/*
+ * Press traces recorded by trace.c, dumped from the device over RTT or recorded in the simulation.
+ *
+ * usage: trace dump <trace>                 print each edge with its time
+ *        trace replay [-v] <trace>          replay a trace on a fresh keyboard and print the host text
+ *        trace record <script> <trace>      run a script and save the trace the keyboard recorded
+ *        trace synth [-t press,gap,pause] [-j jitter] [-b bounce] [-s seed] <text> <trace>
+ *                                           type a text file with an irregular operator and save
+ *                                           the trace, for a sweep corpus (the text is what was meant)
+ *        trace check <script>...            record each script and check the replay reaches the
+ *                                           host exactly as the script did (the scripts can't
+ *                                           change the link, as that isn't in a trace)
+ */
+
+#define TRACE_SETTLE_TIME         3000          // time the keyboard is run for after the last edge (in ms)
+
+static const char * const key_names[] = { "power", "left", "right", "?" };
+
+static uint8_t data[SIM_MAX_TRACE];
+
+
+static bool load(char const * p_path, sim_trace_t * p_trace)
+{
+	uint32_t len = sim_trace_load(p_path, data, sizeof(data));
+
+	if (!sim_trace_parse(data, len, p_trace))
+	{
+		fprintf(stderr, "%s: no trace found\n", p_path);
+		return false;
+	}
+	return true;
+}
+
+
+static int dump(char const * p_path)
+{
+	sim_trace_t trace;
+	sim_trace_edge_t edge;
+	uint32_t pos = 0;
+	uint32_t time;
+	uint32_t count = 0;
+
+	if (!load(p_path, &trace))
+	{
+		return 1;
+	}
+
+	time = trace.start_time;
+	printf("start %u ms, readings 0x%x, %u bytes\n", time * SIM_POLL_INTERVAL, trace.start_state, trace.len);
+	while (sim_trace_next(&trace, &pos, &edge))
+	{
+		time += edge.delta;
+		printf("%8u  %-5s %s\n", time * SIM_POLL_INTERVAL, key_names[edge.key], edge.down ? "down" : "up");
+		count++;
+	}
+	printf("%u edges, %.2f bytes each\n", count, (count > 0) ? (double)trace.len / count : 0.0);
+	return (pos == trace.len) ? 0 : 1;
+}
+
+
+static int replay(char const * p_path, bool verbose)
+{
+	sim_trace_t trace;
+
+	if (!load(p_path, &trace))
+	{
+		return 1;
+	}
+
+	sim_init(verbose);
+	if (!sim_replay_trace(&trace))
+	{
+		fprintf(stderr, "%s: corrupt trace\n", p_path);
+		return 1;
+	}
+	sim_advance(TRACE_SETTLE_TIME);
+	printf("%s: host text \"%s\" after %u ms, %u keys\n", p_path, sim.text, sim.time, sim.report_count);
+	return 0;
+}
+
+
+static bool write_trace(char const * p_out)
+{
+	FILE * p_file = fopen(p_out, "wb");
+	uint16_t len;
+
+	if (p_file == NULL)
+	{
+		perror(p_out);
+		return false;
+	}
+	len = trace_read(0, data, trace_size());
+	fwrite(data, 1, len, p_file);
+	fclose(p_file);
+	return true;
+}
+
+
+static int synth(int argc, char * argv[])
+{
+	typist_timing_t timing = TYPIST_DEFAULT_TIMING;
+	static uint32_t release[SIM_MAX_TEXT];
+	static char text[SIM_MAX_TEXT + 1];
+	uint32_t seed = 1;
+	FILE * p_file;
+	size_t len;
+	int opt;
+
+	timing.jitter = 20;
+	timing.bounce = 10;
+	optind = 2;
+	while ((opt = getopt(argc, argv, "t:j:b:s:")) != -1)
+	{
+		switch (opt)
+		{
+		    case 't':
+				if (sscanf(optarg, "%u,%u,%u", &timing.press, &timing.gap, &timing.pause) != 3)
+				{
+					return 2;
+				}
+				break;
+		    case 'j':
+				timing.jitter = strtoul(optarg, NULL, 10);
+				break;
+		    case 'b':
+				timing.bounce = strtoul(optarg, NULL, 10);
+				break;
+		    case 's':
+				seed = strtoul(optarg, NULL, 10);
+				break;
+		    default:
+				return 2;
+		}
+	}
+	if ((argc - optind) != 2)
+	{
+		return 2;
+	}
+
+	p_file = fopen(argv[optind], "r");
+	if (p_file == NULL)
+	{
+		perror(argv[optind]);
+		return 1;
+	}
+	len = fread(text, 1, SIM_MAX_TEXT, p_file);
+	fclose(p_file);
+	// the text meant is compared without the new line at the end of the file (see sweep.c)
+	while ((len > 0) && (text[len - 1] == '\n'))
+	{
+		len--;
+	}
+	text[len] = '\0';
+
+	sim_init(false);
+	typist_seed(seed);
+	typist_type_text(text, &timing, release, SIM_MAX_TEXT);
+	sim_advance(TRACE_SETTLE_TIME);
+
+	sim_trace_t trace;
+	uint16_t trace_len = trace_read(0, data, trace_size());
+	if (sim_trace_parse(data, trace_len, &trace) && (trace.start_time != 0))
+	{
+		fprintf(stderr, "%s: the trace is too long for the device's buffer and lost its start, split the text\n", argv[optind]);
+		return 1;
+	}
+	printf("%s: host text \"%s\", %u bytes of trace\n", argv[optind + 1], sim.text, trace_size());
+	return write_trace(argv[optind + 1]) ? 0 : 1;
+}
+
+
+// run a script and write the trace recorded, followed by its end time and what reached the host if asked
+static bool record(char const * p_script, char const * p_out, bool with_reports)
+{
+	FILE * p_file;
+
+	sim_init(false);
+	if (sim_run_script(p_script) < 0)
+	{
+		return false;
+	}
+	sim_advance(TRACE_SETTLE_TIME);
+
+	if (!write_trace(p_out))
+	{
+		return false;
+	}
+	if (with_reports)
+	{
+		p_file = fopen(p_out, "ab");
+		if (p_file == NULL)
+		{
+			perror(p_out);
+			return false;
+		}
+		fwrite(&sim.time, sizeof(sim.time), 1, p_file);
+		fwrite(&sim.report_count, sizeof(sim.report_count), 1, p_file);
+		fwrite(sim.reports, sizeof(sim_report_t), MIN(sim.report_count, SIM_MAX_REPORTS), p_file);
+		fwrite(sim.text, 1, sizeof(sim.text), p_file);
+		fclose(p_file);
+	}
+	return true;
+}
+
+
+// replay a recording made by record() and compare what reached the host
+static bool check_replay(char const * p_path)
+{
+	static sim_report_t reports[SIM_MAX_REPORTS];
+	static char text[SIM_MAX_TEXT + 1];
+	uint32_t len = sim_trace_load(p_path, data, sizeof(data));
+	uint32_t end_time;
+	uint32_t report_count;
+	sim_trace_t trace;
+	uint32_t pos;
+
+	if (!sim_trace_parse(data, len, &trace))
+	{
+		return false;
+	}
+	pos = (trace.p_edges - data) + trace.len;
+	memcpy(&end_time, &data[pos], sizeof(end_time));
+	pos += sizeof(end_time);
+	memcpy(&report_count, &data[pos], sizeof(report_count));
+	pos += sizeof(report_count);
+	memcpy(reports, &data[pos], MIN(report_count, SIM_MAX_REPORTS) * sizeof(sim_report_t));
+	pos += MIN(report_count, SIM_MAX_REPORTS) * sizeof(sim_report_t);
+	memcpy(text, &data[pos], sizeof(text));
+
+	sim_init(false);
+	if (!sim_replay_trace(&trace))
+	{
+		return false;
+	}
+	sim_advance_to(end_time);
+
+	if ((sim.report_count != report_count) || (strcmp(sim.text, text) != 0))
+	{
+		printf("%s: replay typed \"%s\" (%u keys), script \"%s\" (%u keys)\n", p_path, sim.text, sim.report_count,
+			   text, report_count);
+		return false;
+	}
+	for (uint32_t i = 0; i < MIN(report_count, SIM_MAX_REPORTS); i++)
+	{
+		if (memcmp(&sim.reports[i], &reports[i], sizeof(sim_report_t)) != 0)
+		{
+			printf("%s: key %u differs, replay 0x%02x/0x%02x at %u ms, script 0x%02x/0x%02x at %u ms\n", p_path, i,
+				   sim.reports[i].key, sim.reports[i].modifiers, sim.reports[i].time, reports[i].key,
+				   reports[i].modifiers, reports[i].time);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+// run a step of a check in its own process, as the keyboard modules keep their own state
+static bool run_child(bool (*p_step)(char const *, char const *, bool), char const * p_a, char const * p_b)
+{
+	int status;
+	pid_t pid;
+
+	fflush(stdout);
+	pid = fork();
+	if (pid == 0)
+	{
+		bool passed = p_step(p_a, p_b, true);
+		fflush(stdout);
+		_exit(passed ? 0 : 1);
+	}
+	waitpid(pid, &status, 0);
+	return WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+
+static bool check_step(char const * p_path, char const * p_unused, bool unused)
+{
+	(void)p_unused;
+	(void)unused;
+	return check_replay(p_path);
+}
+
+
+static int check(int count, char * const * p_scripts)
+{
+	char path[] = "/tmp/keysim-trace-XXXXXX";
+	int fd = mkstemp(path);
+	int failed = 0;
+
+	if (fd < 0)
+	{
+		perror(path);
+		return 2;
+	}
+	close(fd);
+
+	for (int i = 0; i < count; i++)
+	{
+		bool passed = run_child(record, p_scripts[i], path) && run_child(check_step, path, NULL);
+		printf("%-40s %s\n", p_scripts[i], passed ? "replays" : "FAILED");
+		failed += passed ? 0 : 1;
+	}
+
+	unlink(path);
+	return (failed == 0) ? 0 : 1;
+}
+
+
+int main(int argc, char * argv[])
+{
+	if ((argc == 3) && (strcmp(argv[1], "dump") == 0))
+	{
+		return dump(argv[2]);
+	}
+	if ((argc == 3) && (strcmp(argv[1], "replay") == 0))
+	{
+		return replay(argv[2], false);
+	}
+	if ((argc == 4) && (strcmp(argv[1], "replay") == 0) && (strcmp(argv[2], "-v") == 0))
+	{
+		return replay(argv[3], true);
+	}
+	if ((argc == 4) && (strcmp(argv[1], "record") == 0))
+	{
+		return record(argv[2], argv[3], false) ? 0 : 1;
+	}
+	if ((argc >= 3) && (strcmp(argv[1], "check") == 0))
+	{
+		return check(argc - 2, &argv[2]);
+	}
+	if ((argc >= 4) && (strcmp(argv[1], "synth") == 0))
+	{
+		int status = synth(argc, argv);
+		if (status != 2)
+		{
+			return status;
+		}
+	}
+
+	fprintf(stderr, "usage: trace dump <trace>\n"
+			"       trace replay [-v] <trace>\n"
+			"       trace record <script> <trace>\n"
+			"       trace check <script>...\n"
+			"       trace synth [-t press,gap,pause] [-j jitter] [-b bounce] [-s seed] <text> <trace>\n");
+	return 2;
+}
@@ -0,0 +1,174 @@
+#include <string.h>
+
+#include "sim.h"
+#include "typist.h"
+
+#include "codes.h"
+
+static uint32_t random_state = 1;
+
+
+void typist_seed(uint32_t seed)
+{
+	random_state = (seed != 0) ? seed : 1;
+}
+
+
+// xorshift32
+static uint32_t random_next(void)
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+
+// a time varied at random by up to the jitter
+static uint32_t vary(uint32_t time, typist_timing_t const * p_timing)
+{
+	uint32_t range = (time * p_timing->jitter) / 100;
+
+	if (range == 0)
+	{
+		return time;
+	}
+	return time - range + (random_next() % ((range * 2) + 1));
+}
+
+
+// change a button, with the contacts bouncing first if they do
+static void set_key(enum board_key key, bool down, typist_timing_t const * p_timing)
+{
+	if ((p_timing->bounce > 0) && ((random_next() % 100) < p_timing->bounce))
+	{
+		uint8_t bounces = 1 + (random_next() % 3);
+		for (uint8_t i = 0; i < bounces; i++)
+		{
+			sim_set_key(key, down);
+			sim_advance(1 + (random_next() % TYPIST_BOUNCE_TIME));
+			sim_set_key(key, !down);
+			sim_advance(1 + (random_next() % TYPIST_BOUNCE_TIME));
+		}
+	}
+	sim_set_key(key, down);
+}
+
+
+bool typist_type_elements(char const * p_elements, bool alt, uint32_t last_press, typist_timing_t const * p_timing, uint32_t * p_release)
+{
+	if (alt)
+	{
+		set_key(LEFT_KEY, true, p_timing);
+		set_key(RIGHT_KEY, true, p_timing);
+		sim_advance(vary(p_timing->press, p_timing));
+		set_key(LEFT_KEY, false, p_timing);
+		set_key(RIGHT_KEY, false, p_timing);
+		sim_advance(vary(p_timing->gap, p_timing));
+	}
+
+	for (char const * p = p_elements; *p != '\0'; p++)
+	{
+		enum board_key key;
+		bool last = (p[1] == '\0');
+
+		if (*p == '.')
+		{
+			key = LEFT_KEY;
+		}
+		else if (*p == '-')
+		{
+			key = RIGHT_KEY;
+		}
+		else
+		{
+			return false;
+		}
+
+		set_key(key, true, p_timing);
+		sim_advance(vary(last ? last_press : p_timing->press, p_timing));
+		set_key(key, false, p_timing);
+		if (last && (p_release != NULL))
+		{
+			*p_release = sim.time;
+		}
+		sim_advance(vary(last ? p_timing->pause : p_timing->gap, p_timing));
+	}
+	return true;
+}
+
+
+static bool find_in_table(uint16_t const (*table)[4], uint16_t table_size, uint8_t key, uint8_t modifiers, uint16_t * p_code)
+{
+	for (uint16_t i = 0; i < table_size; i++)
+	{
+		if ((table[i][1] == key) && (table[i][2] == modifiers))
+		{
+			*p_code = table[i][0];
+			return true;
+		}
+	}
+	return false;
+}
+
+
+bool typist_find_code(char c, uint16_t * p_code, bool * p_alt)
+{
+	uint8_t key;
+	uint8_t modifiers;
+
+	if (c == '\n')
+	{
+		key = KEY_ENTER;
+		modifiers = 0;
+	}
+	else if (!sim_char_key(c, &key, &modifiers))
+	{
+		return false;
+	}
+
+	*p_alt = false;
+	if (find_in_table(key_table, KEY_TABLE_SIZE, key, modifiers, p_code))
+	{
+		return true;
+	}
+	*p_alt = true;
+	return find_in_table(alt_key_table, ALT_KEY_TABLE_SIZE, key, modifiers, p_code);
+}
+
+
+uint8_t typist_code_elements(uint16_t code, char * p_elements)
+{
+	uint8_t len = 0;
+
+	// the highest bit set marks the start of the code, the first element is the lowest bit
+	while ((code > 1) && (len < TYPIST_MAX_ELEMENTS))
+	{
+		p_elements[len++] = (code & 1) ? '-' : '.';
+		code >>= 1;
+	}
+	p_elements[len] = '\0';
+	return len;
+}
+
+
+uint16_t typist_type_text(char const * p_text, typist_timing_t const * p_timing, uint32_t * p_release, uint16_t max)
+{
+	uint16_t count = 0;
+
+	for (char const * p = p_text; (*p != '\0') && (count < max); p++)
+	{
+		char elements[TYPIST_MAX_ELEMENTS + 1];
+		uint16_t code;
+		bool alt;
+
+		if (!typist_find_code(*p, &code, &alt))
+		{
+			continue;
+		}
+		typist_code_elements(code, elements);
+		typist_type_elements(elements, alt, p_timing->press, p_timing, &p_release[count]);
+		count++;
+	}
+	return count;
+}
@@ -0,0 +1,61 @@
+#ifndef TYPIST_H
+#define TYPIST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Simulated operator, presses the buttons to type codes and text using the code tables in codes.h.
+ *
+ * The operator can be made less regular, with each time varied at random and the button contacts
+ * bouncing, to make press traces that exercise the debouncer and the press classifier.
+ */
+
+#define TYPIST_MAX_ELEMENTS       16
+#define TYPIST_BOUNCE_TIME        8             // longest contact bounce (in ms)
+
+// Operator timing (in ms)
+typedef struct
+{
+	uint32_t press;               // how long each element is pressed for
+	uint32_t gap;                 // time between the elements of a code
+	uint32_t pause;               // time after a code before the next one is started
+	uint32_t jitter;              // most each time is varied by (in % of the time)
+	uint32_t bounce;              // chance of the contacts bouncing when a button changes (in %)
+} typist_timing_t;
+
+#define TYPIST_DEFAULT_TIMING     { 80, 80, 300, 0, 0 }
+
+// seed the random numbers used for jitter and bounce
+void typist_seed(uint32_t seed);
+
+/**@brief Function for pressing the elements of a code.
+ *
+ * @param[in]   p_elements    '.' for the left button and '-' for the right, in the order pressed.
+ * @param[in]   alt           Press both buttons first for the alt keys.
+ * @param[in]   last_press    Time the last element is held for (in ms).
+ * @param[in]   p_timing      Operator timing.
+ * @param[out]  p_release     Virtual time the last element was released, can be NULL.
+ *
+ * @return      false if the elements aren't valid.
+ */
+bool typist_type_elements(char const * p_elements, bool alt, uint32_t last_press, typist_timing_t const * p_timing, uint32_t * p_release);
+
+// find the code that types a character, in the standard key table or the alt key table
+bool typist_find_code(char c, uint16_t * p_code, bool * p_alt);
+
+// write the elements of a code as '.' and '-', returns the number of elements
+uint8_t typist_code_elements(uint16_t code, char * p_elements);
+
+/**@brief Function for typing text.
+ *
+ * @param[in]   p_text        Text, characters that have no code are skipped.
+ * @param[in]   p_timing      Operator timing.
+ * @param[out]  p_release     Virtual time the last element of each character was released.
+ * @param[in]   max           Size of p_release.
+ *
+ * @return      Number of characters typed.
+ */
+uint16_t typist_type_text(char const * p_text, typist_timing_t const * p_timing, uint32_t * p_release, uint16_t max);
+
+#endif // TYPIST_H
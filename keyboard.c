@@ -5,162 +5,1319 @@
 
 #include "nordic_common.h"
 #include "nrf.h"
-#include "nrf_assert.h"
-#include "nrf_gpio.h"
-#include "nrf_delay.h"
 
 #include "common.h"
 #include "codes.h"
 #include "usb_hid_keys.h"
 
-#define POWER_KEY_PIN                    NRF_GPIO_PIN_MAP(0, 26)  // D9
-#define LEFT_KEY_PIN                     NRF_GPIO_PIN_MAP(0, 6)   // D11
-#define RIGHT_KEY_PIN                    NRF_GPIO_PIN_MAP(0, 8)   // D12
-#define LED_PIN                          NRF_GPIO_PIN_MAP(0, 27)  // D10
+/*
+ * Morse decoder, the buttons are read through board_key_down() and keys are sent with send_key()
+ * and the other report functions, so that the decoder doesn't depend on the hardware and can be
+ * run on a host (see host/).
+ */
+
+// debounce settings for each button, a press is accepted on its first reading and the button is
+// then ignored for the lockout time, a release must be integrated over the release samples (the
+// left and right button settings are defaults that can be changed with keyboard_set_timing())
+#define LEFT_KEY_PRESS_LOCKOUT           3                        // poll cycles to ignore chatter after a press
+#define LEFT_KEY_RELEASE_SAMPLES         2                        // net released readings needed for a release
+#define RIGHT_KEY_PRESS_LOCKOUT          3
+#define RIGHT_KEY_RELEASE_SAMPLES        2
+#define POWER_KEY_PRESS_LOCKOUT          5
+#define POWER_KEY_RELEASE_SAMPLES        3
+
+#define MAX_CODE_SIZE                    10                       // max amount of morse code steps (in poll cycles)
+
+#define ADVANCE_TIME                     20                       // default time before advancing to the next morse code step
+#define KEY_HOLD_TIME                    100                      // default time before the key held is repeated
+
+// how a held key is repeated
+#define HOST_REPEAT                      0                        // keep the key pressed and let the host repeat it
+#define DEVICE_REPEAT                    1                        // send a press and release for every repeat
+#define KEY_HOLD_MODE                    HOST_REPEAT
+
+// left, right and backspace are always repeated by the device, speeding up along the repeat curve
+// and then stepping a word at a time (with ctrl)
+#define NAVIGATION_REPEAT_MODE           true
+#define REPEAT_WORD_STEP_COUNT           25                       // repeats before stepping a word at a time (0 to never step words)
+#define REPEAT_WORD_INTERVAL             150                      // time between word steps (in ms)
+#define REPEAT_MAX_BATCH                 4                        // most repeats sent in one burst
+
+#define SPECULATIVE_MODE                 true                     // send keys as soon as they match, correcting them with backspace if the code is extended (switched with a command)
+
+#define CORRECTION_MODE                  true                     // send the nearest key when a code is not in the table (the nearest codes are found by tools/make_keymap.py)
+
+#define NUMERIC_LAYER_DIGITS             0                        // digits in a number before the numeric layer switches off by itself (0 to stay on)
+
+#define WORD_BUFFER_SIZE                 16                       // longest word kept for abbreviation expansion
+
+#define SHIFT_MODIFIERS                  (KEY_MOD_LSHIFT | KEY_MOD_RSHIFT)
+
+#define AUTO_CAPITALISE_MODE             true                     // capitalise the first letter after a sentence ends or a new line
+#define AUTO_SPACE_MODE                  true                     // add the space after punctuation that ends a word when the next word starts (switched with a command)
+#define TEXT_CONTEXT_SIZE                8                        // characters before the cursor remembered
+
+#define KEYBOARD_LOG_MODE                true                     // record the log messages as events, formatted in the idle loop or on a host (see event_trace.c)
+
+#define CLASSIFIER_MODE                  true                     // reject presses that are unlikely to be intended (bumps in turbulence)
+#define MIN_PRESS_TIME                   4                        // presses shorter than this (in poll cycles, between the raw edges) are always rejected
+#define MIN_PRESS_GAP                    4                        // a press starting sooner than this after the last raw release is suspect
+#define SUSPECT_PRESS_PERCENT            75                       // a suspect press must be at least this percent of the average press
+#define PRESS_TIME_DEVIATIONS            3                        // presses shorter than the average by more than this many deviations are rejected
+#define PRESS_STATS_MIN_COUNT            20                       // presses to learn before the average is used
+#define PRESS_STATS_WEIGHT               16                       // each accepted press moves the average 1/n of the way towards it
+#define PRESS_STATS_DEFAULT              8                        // average press time assumed until enough presses have been learned
+
+// Debounced state for a button
+typedef struct
+{
+	bool new;
+	bool state;
+	uint8_t lockout;           // poll cycles left to ignore the button for after a press
+	uint8_t integrator;        // released readings counted towards a release
+	uint8_t press_lockout;     // lockout time after a press
+	uint8_t release_samples;   // integrator count needed for a release
+	uint32_t press_time;       // poll count when the button was last pressed
+	uint32_t release_time;     // poll count of the last released reading of the press, before it was debounced
+} key_reading;
+
+static key_reading left_key;
+static key_reading right_key;
+static key_reading power_key;
+
+enum key_event { NO_CHANGE, PRESSED, RELEASED};
+
+static uint32_t poll_count = 0;                  // time since start up (in poll cycles)
+
+// Decoder timing, the defaults can be changed at run time (e.g. by the host parameter sweep)
+static keyboard_timing_t timing =
+{
+	.advance_time = ADVANCE_TIME,
+	.key_hold_time = KEY_HOLD_TIME,
+	.left_press_lockout = LEFT_KEY_PRESS_LOCKOUT,
+	.left_release_samples = LEFT_KEY_RELEASE_SAMPLES,
+	.right_press_lockout = RIGHT_KEY_PRESS_LOCKOUT,
+	.right_release_samples = RIGHT_KEY_RELEASE_SAMPLES,
+};
+static uint32_t last_release_time = 0;           // time either button was last released (the raw edge, see debounce_key)
+
+// Press time statistics for the current user (scaled by 16)
+static uint16_t press_time_average = PRESS_STATS_DEFAULT * 16;
+static uint16_t press_time_deviation = PRESS_STATS_DEFAULT * 4;
+static uint16_t press_stats_count = 0;
+
+static uint32_t rejected_press_count = 0;
+static uint32_t press_count = 0;                 // presses of the left and right buttons accepted by the debouncer
+
+// All letters of the current word were typed with shift
+static bool word_shifted = false;
+// The first letter of the current word was typed with shift, by the user or at the start of a sentence
+static bool word_first_shifted = false;
+
+// The current word, characters past the end of the buffer are only counted
+static char word_buffer[WORD_BUFFER_SIZE];
+static uint8_t word_buffer_len = 0;
+static uint8_t word_overflow_len = 0;
+
+static bool abbreviation_mode = true;            // expand abbreviations at the end of a word
+
+// Characters before the cursor, empty when they aren't known (at start up or after the cursor is moved)
+static char text_context[TEXT_CONTEXT_SIZE];
+static uint8_t text_context_len = 0;
+
+static bool key_repeat_mode = false;             // the key is being repeated
+static uint16_t key_hold_count = 0;              // time the key has been held for
+static bool key_held = false;                    // a key has been left pressed on the host
+
+// Device repeat curve, the time until the next repeat (in ms) and the number of repeats to send
+// in one burst, for each repeat after the first (the last step is used from then on)
+static const uint8_t repeat_curve[][2] =
+{
+	{100, 1}, {90, 1}, {80, 1}, {70, 1}, {60, 1}, {50, 1}, {40, 1}, {60, 2}, {60, 3}
+};
+
+// Key being repeated by the device
+#define REPEAT_CURVE_STEPS               (sizeof(repeat_curve) / sizeof(repeat_curve[0]))
+static uint8_t repeat_key = 0;
+static uint8_t repeat_modifiers = 0;
+static uint16_t repeat_count = 0;
+
+// Modifier keys (KEY_MOD_*) for the next key only, and locked on until they are released
+static uint8_t one_shot_modifiers = 0;
+static uint8_t locked_modifiers = 0;
+
+// The current morse code
+static uint16_t current_code = 0;
+static uint8_t current_code_pos = 0;
+
+static bool both_btns_pressed = false;
+static bool alt_key_mode = false;
+
+static bool calculator_mode = false;             // keys are added to a calculator expression instead of being sent
+static bool compose_mode = false;                // keys are collected in a line on the keyboard until it is sent
+static bool command_mode = false;                // the next code is a device command
+static bool speculative_mode = SPECULATIVE_MODE;
+static bool auto_space_mode = AUTO_SPACE_MODE;   // off for text where a dot doesn't end a word (e.g. file names)
+static bool numeric_mode = false;                // the numeric layer is used in place of the standard keys
+static uint8_t numeric_digit_count = 0;          // digits typed in the current number
+
+static bool advance_count_active = false;
+static uint16_t advance_count = 0;
+
+// The key already sent for the current code in speculative mode
+static bool speculative_sent = false;
+static uint16_t const (*speculative_table)[4] = NULL;
+static uint16_t speculative_index = 0;
+static bool speculative_space = false;           // a space was added after punctuation before the key
+
+// accept a press on the first reading so there is no delay at the start of an element, then ignore
+// any chatter for the lockout time, a release is only accepted once enough released readings are counted
+static enum key_event debounce_key(key_reading * key, enum board_key pin)
+{
+	enum key_event event = NO_CHANGE;
+	bool reading = board_key_down(pin);
+
+	if (PRESS_TRACE_MODE && (reading != key->new))
+	{
+		trace_edge(pin, reading, poll_count);
+	}
+	if (key->new && !reading)
+	{
+		// the press is timed from the raw edges, as the lockout and release samples hide short presses
+		key->release_time = poll_count;
+	}
+	key->new = reading;
+
+	if (key->lockout > 0)
+	{
+		key->lockout--;
+		return event;
+	}
+
+	if (!key->state)
+	{
+		if (key->new)
+		{
+			event = PRESSED;
+			EVENT_PROBE(EVENT_PRESS, pin, 0);
+			key->state = true;
+			key->press_time = poll_count;
+			key->lockout = key->press_lockout;
+			key->integrator = 0;
+		}
+	}
+	else if (!key->new)
+	{
+		key->integrator++;
+		if (key->integrator >= key->release_samples)
+		{
+			event = RELEASED;
+			EVENT_PROBE(EVENT_RELEASE, pin, 0);
+			key->state = false;
+			key->integrator = 0;
+		}
+	}
+	else if (key->integrator > 0)
+	{
+		key->integrator--;
+	}
+
+	return event;
+}
+
+
+static void key_reading_init(key_reading * key, uint8_t press_lockout, uint8_t release_samples)
+{
+	memset(key, 0, sizeof(key_reading));
+	key->press_lockout = press_lockout;
+	key->release_samples = release_samples;
+}
+
+
+// start a new word
+static void reset_word(void)
+{
+	dictionary_reset();
+	word_shifted = false;
+	word_first_shifted = false;
+	word_buffer_len = 0;
+	word_overflow_len = 0;
+}
+
+
+// add a character to the current word
+static void add_word_char(char c)
+{
+	dictionary_add_char(c);
+	if ((word_buffer_len < WORD_BUFFER_SIZE) && (word_overflow_len == 0))
+	{
+		word_buffer[word_buffer_len++] = c;
+	}
+	else if (word_overflow_len < UINT8_MAX)
+	{
+		word_overflow_len++;
+	}
+}
+
+
+// key code for a lower case letter, digit, space or calculator symbol (see char_needs_shift)
+static uint8_t char_to_key(char c)
+{
+	if ((c >= 'a') && (c <= 'z'))
+	{
+		return KEY_A + (c - 'a');
+	}
+	else if ((c >= '1') && (c <= '9'))
+	{
+		return KEY_1 + (c - '1');
+	}
+
+	switch (c)
+	{
+	    case '0':
+	    case ')':
+			return KEY_0;
+	    case '(':
+			return KEY_9;
+	    case '.':
+			return KEY_DOT;
+	    case '-':
+			return KEY_MINUS;
+	    case '/':
+			return KEY_SLASH;
+	    case '=':
+	    case '+':
+			return KEY_EQUAL;
+	}
+	return KEY_SPACE;
+}
+
+
+// check if the key for a character from char_to_key is typed with shift
+static bool char_needs_shift(char c)
+{
+	return (c == '(') || (c == ')') || (c == '+');
+}
+
+
+// character typed by a key, returns 0 if it isn't one that is used for calculations or sentences
+static char key_to_char(uint8_t key, bool shift)
+{
+	if ((key >= KEY_A) && (key <= KEY_Z))
+	{
+		return 'a' + (key - KEY_A);
+	}
+
+	if (shift)
+	{
+		switch (key)
+		{
+		    case KEY_9:
+				return '(';
+		    case KEY_0:
+				return ')';
+		    case KEY_EQUAL:
+				return '+';
+		    case KEY_1:
+				return '!';
+		    case KEY_SLASH:
+				return '?';
+		    case KEY_SEMICOLON:
+				return ':';
+		}
+		return 0;
+	}
+
+	if ((key >= KEY_1) && (key <= KEY_9))
+	{
+		return '1' + (key - KEY_1);
+	}
+
+	switch (key)
+	{
+	    case KEY_0:
+			return '0';
+	    case KEY_DOT:
+			return '.';
+	    case KEY_MINUS:
+			return '-';
+	    case KEY_SLASH:
+			return '/';
+	    case KEY_EQUAL:
+			return '=';
+	    case KEY_COMMA:
+			return ',';
+	    case KEY_SEMICOLON:
+			return ';';
+	    case KEY_SPACE:
+			return ' ';
+	    case KEY_ENTER:
+			return '\n';
+	}
+	return 0;
+}
+
+
+// remember the text typed before the cursor
+static void track_text(uint8_t key, bool shift)
+{
+	char c = key_to_char(key, shift);
+
+	if (key == KEY_BACKSPACE)
+	{
+		if (text_context_len > 0)
+		{
+			text_context_len--;
+		}
+		return;
+	}
+
+	if (c == 0)
+	{
+		if ((key < KEY_A) || (key > KEY_SLASH) || (key == KEY_ESC) || (key == KEY_TAB))
+		{
+			// the cursor may have moved
+			text_context_len = 0;
+			return;
+		}
+		c = '#';  // any other symbol
+	}
+
+	if (text_context_len == TEXT_CONTEXT_SIZE)
+	{
+		memmove(text_context, &text_context[1], TEXT_CONTEXT_SIZE - 1);
+		text_context_len--;
+	}
+	text_context[text_context_len++] = c;
+}
+
+
+// check if the cursor is at the start of a sentence, after . ! ? and spaces, or a new line
+static bool sentence_start(void)
+{
+	uint8_t i = text_context_len;
+
+	if ((i > 0) && (text_context[i - 1] == '\n'))
+	{
+		return true;
+	}
+	if ((i == 0) || (text_context[i - 1] != ' '))
+	{
+		return false;
+	}
+	while ((i > 0) && (text_context[i - 1] == ' '))
+	{
+		i--;
+	}
+	return (i > 0) && ((text_context[i - 1] == '.') || (text_context[i - 1] == '!') ||
+					   (text_context[i - 1] == '?') || (text_context[i - 1] == '\n'));
+}
+
+
+// check if the cursor is straight after punctuation that ends a word, so the next word needs a
+// space (punctuation after a digit is left alone, as in 121.5 or 12:30)
+static bool space_pending(void)
+{
+	uint8_t i = text_context_len;
+
+	if (i < 2)
+	{
+		return false;
+	}
+	char c = text_context[i - 1];
+	return ((c == '.') || (c == ',') || (c == ';') || (c == ':') || (c == '!') || (c == '?')) &&
+		   (text_context[i - 2] >= 'a') && (text_context[i - 2] <= 'z');
+}
+
+
+// follow the text that has been typed, so that the current word is known
+static void track_key(uint8_t key, uint8_t modifiers)
+{
+	bool shift = (modifiers & SHIFT_MODIFIERS) != 0;
+
+	if ((modifiers & ~SHIFT_MODIFIERS) != 0)
+	{
+		// a shortcut, which may change the text or move the cursor
+		reset_word();
+		text_context_len = 0;
+		return;
+	}
+
+	track_text(key, shift);
+
+	if ((key >= KEY_A) && (key <= KEY_Z))
+	{
+		if (dictionary_word_empty())
+		{
+			word_first_shifted = shift;
+		}
+		word_shifted = shift && (word_shifted || dictionary_word_empty());
+		add_word_char('a' + (key - KEY_A));
+	}
+	else if ((key >= KEY_1) && (key <= KEY_0) && !shift)
+	{
+		add_word_char((key == KEY_0) ? '0' : '1' + (key - KEY_1));
+	}
+	else if (key == KEY_BACKSPACE)
+	{
+		dictionary_remove_char();
+		if (word_overflow_len > 0)
+		{
+			word_overflow_len--;
+		}
+		else if (word_buffer_len > 0)
+		{
+			word_buffer_len--;
+		}
+	}
+	else
+	{
+		reset_word();
+	}
+}
+
+
+// send a key to the host
+static void emit_key(uint8_t key, uint8_t modifiers)
+{
+	send_key(key, modifiers);
+	track_key(key, modifiers);
+}
+
+
+// press a key and leave it pressed for the host to repeat, the number of repeats isn't known so
+// the current word is lost
+static void emit_key_hold(uint8_t key, uint8_t modifiers)
+{
+	send_key_hold(key, modifiers);
+	reset_word();
+	text_context_len = 0;
+}
+
+
+// send a string of keys (modifier and key code for each) in one burst
+static void emit_keys(uint8_t const * p_keys, uint8_t count)
+{
+	send_keys(p_keys, count);
+	for (uint8_t i = 0; i < count; i++)
+	{
+		track_key(p_keys[(i * 2) + 1], p_keys[i * 2]);
+	}
+}
+
+
+// type the rest of the most likely word starting with the current word
+static void complete_word(void)
+{
+	char completion[DICTIONARY_MAX_COMPLETION];
+	uint8_t keys[DICTIONARY_MAX_COMPLETION * 2];
+	uint8_t len = dictionary_completion(completion, sizeof(completion));
+
+	for (uint8_t i = 0; i < len; i++)
+	{
+		keys[i * 2] = word_shifted ? KEY_MOD_LSHIFT : 0;
+		keys[(i * 2) + 1] = char_to_key(completion[i]);
+	}
+
+	if (len > 0)
+	{
+		EVENT_LOG(KEYBOARD_LOG_MODE, LOG_COMPLETE_WORD, len);
+		emit_keys(keys, len);
+	}
+}
+
+
+// at the end of a word replace an abbreviation with its expansion, the backspaces, expansion and
+// the key ending the word are sent in one burst, returns false if the word isn't an abbreviation
+static bool expand_abbreviation(uint8_t end_key)
+{
+	uint8_t keys[(WORD_BUFFER_SIZE + ABBREVIATION_MAX_EXPANSION + 1) * 2];
+	uint8_t count = 0;
+
+	if (!abbreviation_mode || (word_overflow_len > 0))
+	{
+		return false;
+	}
+
+	char const * p_expansion = abbreviation_find(word_buffer, word_buffer_len);
+	if (p_expansion == NULL)
+	{
+		return false;
+	}
+
+	for (uint8_t i = 0; i < word_buffer_len; i++)
+	{
+		keys[count * 2] = 0;
+		keys[(count * 2) + 1] = KEY_BACKSPACE;
+		count++;
+	}
+
+	for (uint8_t i = 0; (p_expansion[i] != '\0') && (i < ABBREVIATION_MAX_EXPANSION); i++)
+	{
+		bool shift = word_shifted || ((i == 0) && word_first_shifted);
+		keys[count * 2] = (shift && (p_expansion[i] != ' ')) ? KEY_MOD_LSHIFT : 0;
+		keys[(count * 2) + 1] = char_to_key(p_expansion[i]);
+		count++;
+	}
+
+	keys[count * 2] = 0;
+	keys[(count * 2) + 1] = end_key;
+	count++;
+
+	EVENT_LOG(KEYBOARD_LOG_MODE, LOG_EXPAND_ABBREVIATION, count);
+	emit_keys(keys, count);
+	return true;
+}
+
+
+// add a key to the calculator expression, the result is typed in one burst when it is evaluated
+// with = or enter, nothing is sent to the host until then
+static void calculate_key(uint8_t key, bool shift)
+{
+	char result[CALCULATOR_MAX_RESULT];
+	uint8_t keys[CALCULATOR_MAX_RESULT * 2];
+	char c = key_to_char(key, shift);
+
+	if (key == KEY_BACKSPACE)
+	{
+		calculator_remove_char();
+	}
+	else if (key == KEY_ESC)
+	{
+		calculator_reset();
+		calculator_mode = false;
+		EVENT_LOG(KEYBOARD_LOG_MODE, LOG_CALCULATOR, calculator_mode);
+	}
+	else if ((key == KEY_ENTER) || (c == '='))
+	{
+		uint8_t len = calculator_evaluate(result, sizeof(result));
+		for (uint8_t i = 0; i < len; i++)
+		{
+			keys[i * 2] = char_needs_shift(result[i]) ? KEY_MOD_LSHIFT : 0;
+			keys[(i * 2) + 1] = char_to_key(result[i]);
+		}
+		EVENT_LOG(KEYBOARD_LOG_MODE, LOG_CALCULATOR_RESULT, len);
+		emit_keys(keys, len);
+		calculator_mode = false;
+	}
+	else if ((c != 0) && (c != ' '))
+	{
+		UNUSED_RETURN_VALUE(calculator_add_char(c));
+	}
+}
+
+
+// modifier key for a modifier function
+static uint8_t function_modifier(uint16_t function)
+{
+	switch (function)
+	{
+	    case FN_MOD_SHIFT:
+			return KEY_MOD_LSHIFT;
+	    case FN_MOD_CTRL:
+			return KEY_MOD_LCTRL;
+	    case FN_MOD_ALT:
+			return KEY_MOD_LALT;
+	    case FN_MOD_GUI:
+			return KEY_MOD_LMETA;
+	}
+	return 0;
+}
+
+
+// step a modifier from off, to on for the next key, to locked on, and back to off
+static void toggle_modifier(uint8_t modifier)
+{
+	if (locked_modifiers & modifier)
+	{
+		locked_modifiers &= ~modifier;
+	}
+	else if (one_shot_modifiers & modifier)
+	{
+		one_shot_modifiers &= ~modifier;
+		locked_modifiers |= modifier;
+	}
+	else
+	{
+		one_shot_modifiers |= modifier;
+	}
+	EVENT_LOG(KEYBOARD_LOG_MODE, LOG_MODIFIERS, EVENT_LOG_PAIR(one_shot_modifiers, locked_modifiers));
+}
+
+
+// send the line that has been composed in one packed burst
+static void send_composed_line(void)
+{
+	uint8_t const * p_keys;
+	uint8_t count = compose_line(&p_keys);
+
+	EVENT_LOG(KEYBOARD_LOG_MODE, LOG_SEND_LINE, count);
+	send_keys_packed(p_keys, count);
+	for (uint8_t i = 0; i < count; i++)
+	{
+		track_key(p_keys[(i * 2) + 1], p_keys[i * 2]);
+	}
+	compose_reset();
+	compose_mode = false;
+}
+
+
+// edit the line being composed, nothing is sent to the host until the line is finished
+static void compose_key(uint8_t key, uint8_t modifiers)
+{
+	bool word = (modifiers & (KEY_MOD_LCTRL | KEY_MOD_RCTRL)) != 0;
+
+	switch (key)
+	{
+	    case KEY_BACKSPACE:
+			compose_backspace(word);
+			break;
+	    case KEY_LEFT:
+			compose_move(false, word);
+			break;
+	    case KEY_RIGHT:
+			compose_move(true, word);
+			break;
+	    case KEY_ESC:
+			compose_reset();
+			compose_mode = false;
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_COMPOSE, compose_mode);
+			break;
+	    case KEY_ENTER:
+			send_composed_line();
+			emit_key(KEY_ENTER, 0);
+			break;
+	    default:
+			// shortcuts can't be composed
+			if (((modifiers & ~SHIFT_MODIFIERS) == 0) && !compose_insert(key, modifiers))
+			{
+				EVENT_LOG(KEYBOARD_LOG_MODE, LOG_COMPOSE_LINE_FULL, 0);
+			}
+			break;
+	}
+}
+
+
+// type the battery level as text
+static void type_battery_level(void)
+{
+	uint8_t keys[4 * 2];
+	uint8_t level = get_battery_level();
+	uint8_t count = 0;
+
+	if (level >= 100)
+	{
+		keys[count * 2] = 0;
+		keys[(count * 2) + 1] = KEY_1;
+		count++;
+	}
+	if (level >= 10)
+	{
+		keys[count * 2] = 0;
+		keys[(count * 2) + 1] = char_to_key('0' + ((level / 10) % 10));
+		count++;
+	}
+	keys[count * 2] = 0;
+	keys[(count * 2) + 1] = char_to_key('0' + (level % 10));
+	count++;
+	keys[count * 2] = KEY_MOD_LSHIFT;   // %
+	keys[(count * 2) + 1] = KEY_5;
+	count++;
+
+	emit_keys(keys, count);
+}
+
+
+// carry out a device function from the code tables
+static void process_function(uint16_t function)
+{
+	switch (function)
+	{
+	    case FN_COMPLETE_WORD:
+			complete_word();
+			break;
+	    case FN_ABBREVIATION_TOGGLE:
+			abbreviation_mode = !abbreviation_mode;
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_ABBREVIATIONS, abbreviation_mode);
+			break;
+	    case FN_CALCULATOR:
+			calculator_mode = !calculator_mode;
+			calculator_reset();
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_CALCULATOR, calculator_mode);
+			break;
+	    case FN_COMPOSE:
+			if (compose_mode)
+			{
+				send_composed_line();
+			}
+			else
+			{
+				compose_reset();
+				compose_mode = true;
+				EVENT_LOG(KEYBOARD_LOG_MODE, LOG_COMPOSE, compose_mode);
+			}
+			break;
+	    case FN_COMMAND:
+			command_mode = true;
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_COMMAND, 0);
+			break;
+	    case FN_CMD_PAIR:
+			start_pair_mode();
+			bluetooth_pair();
+			break;
+	    case FN_CMD_NEXT_PEER:
+			bluetooth_next_peer();
+			break;
+	    case FN_CMD_BATTERY:
+			if (bluetooth_is_connected())
+			{
+				type_battery_level();
+			}
+			break;
+	    case FN_CMD_POWER_PROFILE:
+			bluetooth_toggle_power_profile();
+			break;
+	    case FN_CMD_INPUT_MODE:
+			speculative_mode = !speculative_mode;
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_SPECULATIVE, speculative_mode);
+			break;
+	    case FN_CMD_AUTO_SPACE:
+			auto_space_mode = !auto_space_mode;
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_AUTO_SPACE, auto_space_mode);
+			break;
+	    case FN_CMD_OFF:
+			set_device_state(OFF);
+			break;
+	    case FN_CMD_TRACE:
+			trace_dump_start();
+			event_trace_dump_start();
+			break;
+	    case FN_NUMERIC_LAYER:
+			numeric_mode = !numeric_mode;
+			numeric_digit_count = 0;
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_NUMERIC_LAYER, numeric_mode);
+			break;
+	}
+}
 
-#define MAX_CODE_SIZE                    10                       // max amount of morse code steps (in poll cycles)
 
-#define ADVANCE_TIME                     20                       // time before advancing to the next morse code step
-#define KEY_HOLD_TIME                    100                      // time before the key held is repeated
-#define KEY_REPEAT_TIME                  10                       // speed the key is repeated
+// find the table entry for the current code, returns -1 if the code is unknown
+static int16_t find_code(uint16_t const (**p_table)[4])
+{
+	uint8_t const * p_index;
+	uint16_t index_size;
 
-// Debounced state for a button
-typedef struct
+	uint16_t code = current_code | (1 << current_code_pos);  // add a 1 bit to mark the end of the code
+
+	if (alt_key_mode)
+	{
+		*p_table = alt_key_table;
+		p_index = alt_key_table_index;
+		index_size = ALT_KEY_TABLE_INDEX_SIZE;
+	}
+	else if (command_mode)
+	{
+		*p_table = command_key_table;
+		p_index = command_key_table_index;
+		index_size = COMMAND_KEY_TABLE_INDEX_SIZE;
+	}
+	else if (numeric_mode)
+	{
+		*p_table = numeric_key_table;
+		p_index = numeric_key_table_index;
+		index_size = NUMERIC_KEY_TABLE_INDEX_SIZE;
+	}
+	else
+	{
+		*p_table = key_table;
+		p_index = key_table_index;
+		index_size = KEY_TABLE_INDEX_SIZE;
+	}
+
+	if ((code >= index_size) || (p_index[code] == CODE_NO_ENTRY))
+	{
+		return -1;
+	}
+	return p_index[code];
+}
+
+
+// find the nearest table entry for a code that is not in the table, returns -1 if there isn't a clear one
+static int16_t find_nearest_code(uint16_t const (**p_table)[4])
 {
-	bool prev;
-	bool new;
-	bool state;
-} key_reading;
+	uint8_t const * p_nearest;
 
-static key_reading left_key;
-static key_reading right_key;
-static key_reading power_key;
+	if (current_code_pos > CORRECTION_MAX_CODE_SIZE)
+	{
+		return -1;
+	}
 
-enum key_event { NO_CHANGE, PRESSED, RELEASED};
+	uint16_t code = current_code | (1 << current_code_pos);
 
-static bool key_repeat_mode = false;             // the key is being repeated
-static uint16_t key_hold_count = 0;              // time the key has been held for
+	if (alt_key_mode)
+	{
+		*p_table = alt_key_table;
+		p_nearest = alt_key_table_nearest;
+	}
+	else if (numeric_mode)
+	{
+		*p_table = numeric_key_table;
+		p_nearest = numeric_key_table_nearest;
+	}
+	else
+	{
+		*p_table = key_table;
+		p_nearest = key_table_nearest;
+	}
 
-static bool shift_mode = false;
+	return (p_nearest[code] == CODE_NO_ENTRY) ? -1 : p_nearest[code];
+}
 
-// The current morse code
-static uint16_t current_code = 0;
-static uint8_t current_code_pos = 0;
 
-static bool both_btns_pressed = false;
-static bool alt_key_mode = false;
+// clear the current code ready for the next one
+static void reset_code(void)
+{
+	current_code = 0;
+	current_code_pos = 0;
+	EVENT_LOG(KEYBOARD_LOG_MODE, LOG_CODE_RESET, 0);
+	alt_key_mode = false;
+	advance_count_active = false;
+	speculative_sent = false;
+}
+
+
+// check if a held key steps a word at a time once it has been repeated for a while
+static bool repeat_steps_words(uint8_t key)
+{
+	return ((key == KEY_LEFT) || (key == KEY_RIGHT) || (key == KEY_BACKSPACE)) && (REPEAT_WORD_STEP_COUNT > 0);
+}
 
-static bool advance_count_active = false;
-static uint16_t advance_count = 0;
 
-bool pair_mode = false;
+// check if a held key repeats while an expression or a line is being edited on the keyboard
+static bool repeat_edits(uint8_t key)
+{
+	return (key == KEY_BACKSPACE) || (compose_mode && ((key == KEY_LEFT) || (key == KEY_RIGHT)));
+}
 
 
-void toggle_led(void)
+// start repeating a key that has been held, the first repeat comes after the first step of the curve
+static void repeat_start(uint8_t key, uint8_t modifiers)
 {
-	nrf_gpio_pin_toggle(LED_PIN);
+	repeat_key = key;
+	repeat_modifiers = modifiers;
+	repeat_count = 0;
+	start_key_repeat_timer(repeat_curve[0][0]);
 }
 
 
-/**@brief Function for putting the chip into sleep mode.
+/**@brief Function for sending the next repeats of the key held, called by the key repeat timer.
  *
- * @note This function will not return.
+ * @details Follows repeat_curve, and for navigation keys steps a word at a time after
+ *          REPEAT_WORD_STEP_COUNT repeats. Repeats due in the same step are sent as one burst,
+ *          or applied to the calculator expression or the composed line when one is being edited.
  */
-void sleep_mode_enter(bool all_btns_wake)
+void key_repeat(void)
 {
-    ret_code_t err_code;
+	uint8_t keys[REPEAT_MAX_BATCH * 2] = {0};
+	uint8_t count = 0;
+	uint16_t interval;
 
-	// delay as the power key sense isn't debounced
-	nrf_delay_ms(30);
+	if (!key_repeat_mode || (repeat_key == 0))
+	{
+		return;
+	}
 
-	// set which keys will wake the device
-	nrf_gpio_cfg_sense_input(POWER_KEY_PIN, NRF_GPIO_PIN_PULLUP, NRF_GPIO_PIN_SENSE_LOW);
-	if (all_btns_wake) {
-		nrf_gpio_cfg_sense_input(LEFT_KEY_PIN, NRF_GPIO_PIN_PULLUP, NRF_GPIO_PIN_SENSE_LOW);
-		nrf_gpio_cfg_sense_input(RIGHT_KEY_PIN, NRF_GPIO_PIN_PULLUP, NRF_GPIO_PIN_SENSE_LOW);
+	if (repeat_steps_words(repeat_key) && (repeat_count >= REPEAT_WORD_STEP_COUNT))
+	{
+		count = 1;
+		interval = REPEAT_WORD_INTERVAL;
+		keys[0] = repeat_modifiers | KEY_MOD_LCTRL;
+		keys[1] = repeat_key;
+	}
+	else
+	{
+		uint8_t step = MIN(repeat_count, REPEAT_CURVE_STEPS - 1);
+		count = MIN(repeat_curve[step][1], REPEAT_MAX_BATCH);
+		interval = repeat_curve[step][0];
+		for (uint8_t i = 0; i < count; i++)
+		{
+			keys[i * 2] = repeat_modifiers;
+			keys[(i * 2) + 1] = repeat_key;
+		}
 	}
 
-	pair_mode = false;
+	for (uint8_t i = 0; (i < count) && (calculator_mode || compose_mode); i++)
+	{
+		if (calculator_mode)
+		{
+			calculate_key(keys[(i * 2) + 1], false);
+		}
+		else
+		{
+			compose_key(keys[(i * 2) + 1], keys[i * 2]);
+		}
+	}
+	if (!calculator_mode && !compose_mode)
+	{
+		emit_keys(keys, count);
+	}
+	if (repeat_count < UINT16_MAX)
+	{
+		repeat_count++;
+	}
+	start_key_repeat_timer(interval);
+}
 
-	nrf_gpio_pin_clear(LED_PIN);
 
-    // Go to system-off mode (this function will not return; wakeup will cause a reset).
-    err_code = sd_power_system_off();
-    APP_ERROR_CHECK(err_code);
+// remove the key sent speculatively for the current code, and the space added before it
+static void remove_speculative_key(void)
+{
+	emit_key(KEY_BACKSPACE, 0);
+	if (speculative_space)
+	{
+		emit_key(KEY_BACKSPACE, 0);
+	}
+	speculative_space = false;
 }
 
 
-// ensure that a button press or release is maintained for a minimum time period
-static enum key_event debounce_key(key_reading * key, uint32_t pin)
+// send a key, replacing the key sent speculatively for the current code if there is one,
+// letters get the space after punctuation and the capital at the start of a sentence
+static void send_code_key(uint16_t const (*table)[4], int16_t index)
 {
-	enum key_event event = NO_CHANGE;
-	
-	key->new = !nrf_gpio_pin_read(pin);
+	uint8_t key = table[index][1];
+	uint8_t modifiers = one_shot_modifiers | locked_modifiers | table[index][2];
+	bool letter = ((key >= KEY_A) && (key <= KEY_Z)) && ((modifiers & ~SHIFT_MODIFIERS) == 0);
+	bool space_sent = false;
 
-	if ((key->new != key->prev) && (key->new != key->state))
+	if (speculative_sent)
 	{
-		if (key->new && !key->state)
+		if ((table == speculative_table) && (index == speculative_index))
 		{
-			event = PRESSED;
+			return;
 		}
-		else if (!key->new && key->state)
+		emit_key(KEY_BACKSPACE, 0);
+		if (speculative_space)
 		{
-			event = RELEASED;
+			// the space is kept for a letter
+			if (letter)
+			{
+				space_sent = true;
+			}
+			else
+			{
+				emit_key(KEY_BACKSPACE, 0);
+			}
 		}
-		key->state = key->new;
+		EVENT_LOG(KEYBOARD_LOG_MODE, LOG_SPECULATIVE_CORRECTED, 0);
+		speculative_sent = false;
 	}
 
-	key->prev = key->new;
-	return event;
+	if (letter && auto_space_mode && space_pending())
+	{
+		emit_key(KEY_SPACE, 0);
+		space_sent = true;
+	}
+	speculative_space = space_sent;
+
+	if (letter && AUTO_CAPITALISE_MODE && sentence_start() && !bluetooth_caps_lock_on())
+	{
+		modifiers |= KEY_MOD_LSHIFT;
+	}
+
+	if (key_repeat_mode && (KEY_HOLD_MODE == HOST_REPEAT) && !(NAVIGATION_REPEAT_MODE && repeat_steps_words(key)))
+	{
+		emit_key_hold(key, modifiers);
+		key_held = true;
+	}
+	else if (key_repeat_mode)
+	{
+		emit_key(key, modifiers);
+		repeat_start(key, modifiers);
+	}
+	else if (((key == KEY_SPACE) || (key == KEY_ENTER)) && expand_abbreviation(key))
+	{
+		return;
+	}
+	else
+	{
+		emit_key(key, modifiers);
+	}
+	EVENT_LOG(KEYBOARD_LOG_MODE, LOG_SEND_KEY, EVENT_LOG_PAIR(key, modifiers));
+}
+
+
+// keep the numeric layer on while a number is being typed, any other key switches it off
+static void update_numeric_layer(uint16_t key)
+{
+	if ((key >= KEY_1) && (key <= KEY_0))
+	{
+		numeric_digit_count++;
+#if NUMERIC_LAYER_DIGITS > 0
+		if (numeric_digit_count >= NUMERIC_LAYER_DIGITS)
+		{
+			numeric_mode = false;
+		}
+#endif
+	}
+	else if (key == KEY_SPACE)
+	{
+		numeric_digit_count = 0;
+	}
+	else if (key == KEY_BACKSPACE)
+	{
+		if (numeric_digit_count > 0)
+		{
+			numeric_digit_count--;
+		}
+	}
+	else if ((key != KEY_DOT) && (key != KEY_MINUS))
+	{
+		numeric_mode = false;
+	}
+
+	if (!numeric_mode)
+	{
+		EVENT_LOG(KEYBOARD_LOG_MODE, LOG_NUMERIC_LAYER, numeric_mode);
+	}
 }
 
 
 // make the appropriate action for the code that has been entered
 void process_code()
 {
-	uint16_t (*table)[3];
-	uint16_t table_size;
+	uint16_t const (*table)[4];
+	uint16_t code = current_code | (1 << current_code_pos);
+	uint8_t const * p_macro_keys;
+	uint8_t macro_count;
 
-	uint16_t code = current_code | (1 << current_code_pos);  // add a 1 bit to mark the end of the code
-	
-	if (bluetooth_is_connected())
+	EVENT_PROBE(EVENT_CODE, 0, code);
+
+	if (command_mode && !alt_key_mode)
 	{
-		if (alt_key_mode)
+		// device commands work without a connection and aren't corrected
+		int16_t index = find_code(&table);
+		command_mode = false;
+		if (index >= 0)
 		{
-			table = alt_key_table;
-			table_size = ALT_KEY_TABLE_SIZE;
+			process_function(table[index][1]);
 		}
 		else
 		{
-			table = key_table;
-			table_size = KEY_TABLE_SIZE;
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_UNKNOWN_COMMAND, code);
+		}
+		return;
+	}
+
+	if (bluetooth_is_connected())
+	{
+		int16_t index = find_code(&table);
+		if ((index < 0) && alt_key_mode && macro_find(code, &p_macro_keys, &macro_count))
+		{
+			// macros share codes with the alt keys
+			if (speculative_sent)
+			{
+				remove_speculative_key();
+			}
+			emit_keys(p_macro_keys, macro_count);
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_SEND_MACRO, macro_count);
+			one_shot_modifiers = 0;
+			speculative_sent = false;
+			return;
 		}
 
-		for (int i = 0; i < table_size; i++)
+		if ((index < 0) && CORRECTION_MODE)
 		{
-			if (table[i][0] == code)
+			index = find_nearest_code(&table);
+			if (index >= 0)
+			{
+				// the code entered was recorded by the EVENT_CODE probe
+				EVENT_LOG(KEYBOARD_LOG_MODE, LOG_CODE_CORRECTED, table[index][0]);
+			}
+		}
+
+		if (index >= 0)
+		{
+			if (function_modifier(table[index][1]) != 0)
+			{
+				toggle_modifier(function_modifier(table[index][1]));
+			}
+			else if (table[index][1] >= FN_FIRST)
+			{
+				process_function(table[index][1]);
+				one_shot_modifiers = 0;
+			}
+			else if (calculator_mode)
+			{
+				calculate_key(table[index][1], ((one_shot_modifiers | locked_modifiers | table[index][2]) & SHIFT_MODIFIERS) != 0);
+				if (key_repeat_mode && repeat_edits(table[index][1]))
+				{
+					repeat_start(table[index][1], 0);
+				}
+				one_shot_modifiers = 0;
+			}
+			else if (compose_mode)
 			{
-				if (table[i][1] == KEY_MOD_LSHIFT)
+				compose_key(table[index][1], one_shot_modifiers | locked_modifiers | table[index][2]);
+				if (key_repeat_mode && repeat_edits(table[index][1]))
+				{
+					repeat_start(table[index][1], one_shot_modifiers | locked_modifiers | table[index][2]);
+				}
+				one_shot_modifiers = 0;
+				if (numeric_mode)
 				{
-					shift_mode = !shift_mode;
-					NRF_LOG_INFO("SHIFT SET: %d", shift_mode);
+					update_numeric_layer(table[index][1]);
 				}
-				else
+			}
+			else
+			{
+				send_code_key(table, index);
+				one_shot_modifiers = 0;
+				if (numeric_mode)
 				{
-					send_key(table[i][1], shift_mode | table[i][2]);
-					NRF_LOG_INFO("Send Key: %d / %d", table[i][1], table[i][2]);
-					shift_mode = false;
+					update_numeric_layer(table[index][1]);
 				}
-				return;
 			}
 		}
-		NRF_LOG_INFO("Unknown Key Code Entered: %d", code);
+		else
+		{
+			if (speculative_sent)
+			{
+				// remove the key that was sent for the start of the code
+				remove_speculative_key();
+			}
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_UNKNOWN_CODE, code);
+		}
+	}
+	else if (alt_key_mode)
+	{
+		// the device command code can be reached without a connection
+		int16_t index = find_code(&table);
+		if ((index >= 0) && (table[index][1] == FN_COMMAND))
+		{
+			process_function(FN_COMMAND);
+		}
+	}
+	speculative_sent = false;
+}
+
+
+// send the code as soon as an element is entered if no longer code could follow it,
+// or in speculative mode if the code is the start of longer codes
+static void process_partial_code(void)
+{
+	uint16_t const (*table)[4];
+
+	if (!bluetooth_is_connected())
+	{
+		return;
+	}
+
+	int16_t index = find_code(&table);
+	if (index < 0)
+	{
+		return;
+	}
+
+	// a longer macro code may follow an alt key
+	bool macro_prefix = alt_key_mode && macro_is_prefix(current_code | (1 << current_code_pos));
+
+	if ((table[index][3] == CODE_LEAF) && !macro_prefix)
+	{
+		process_code();
+		reset_code();
+	}
+	else if (speculative_mode && !calculator_mode && !compose_mode && (table[index][3] == CODE_SPECULATE) &&
+			 (((one_shot_modifiers | locked_modifiers) & ~SHIFT_MODIFIERS) == 0))
+	{
+		// a shortcut can't be taken back with backspace, so it waits for the whole code
+		send_code_key(table, index);
+		speculative_sent = true;
+		speculative_table = table;
+		speculative_index = index;
+	}
+}
+
+
+// learn how long the user normally holds a button for
+static void update_press_stats(uint32_t duration)
+{
+	int32_t scaled = MIN(duration, UINT16_MAX / 16) * 16;
+	int32_t diff = scaled - press_time_average;
+
+	press_time_average += diff / PRESS_STATS_WEIGHT;
+	press_time_deviation += (abs(diff) - press_time_deviation) / PRESS_STATS_WEIGHT;
+
+	if (press_stats_count < PRESS_STATS_MIN_COUNT)
+	{
+		press_stats_count++;
+	}
+}
+
+
+// decide if a released press was intended, using how long it was held, how soon it followed the
+// last release and whether it happened entirely while the other button was held (the press is
+// timed from its first pressed reading to its last released reading, not the debounced release)
+static bool classify_press(key_reading * key, key_reading * other)
+{
+	uint32_t duration = key->release_time - key->press_time;
+	uint32_t gap = key->press_time - last_release_time;
+	bool nested = other->state && (other->press_time <= key->press_time);
+
+	if (!CLASSIFIER_MODE)
+	{
+		return true;
+	}
+
+	if (duration < MIN_PRESS_TIME)
+	{
+		EVENT_LOG(KEYBOARD_LOG_MODE, LOG_PRESS_TOO_SHORT, duration);
+		return false;
+	}
+
+	if (press_stats_count >= PRESS_STATS_MIN_COUNT)
+	{
+		int32_t limit = press_time_average - PRESS_TIME_DEVIATIONS * press_time_deviation;
+		if ((int32_t)(duration * 16) < limit)
+		{
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_PRESS_SHORTER, duration);
+			return false;
+		}
+	}
+
+	if (((gap < MIN_PRESS_GAP) || nested) &&
+		((duration * 16 * 100) < (press_time_average * SUSPECT_PRESS_PERCENT)))
+	{
+		EVENT_LOG(KEYBOARD_LOG_MODE, LOG_PRESS_SUSPECT, EVENT_LOG_PAIR(duration, gap));
+		return false;
 	}
+
+	update_press_stats(duration);
+	return true;
+}
+
+
+uint32_t get_rejected_press_count(void)
+{
+	return rejected_press_count;
+}
+
+
+uint32_t get_press_count(void)
+{
+	return press_count;
 }
 
 
-static void process_key_event(enum key_event event, bool other_state, uint8_t bit)
+static void process_key_event(enum key_event event, key_reading * key, key_reading * other, uint8_t bit)
 {
+	bool other_state = other->state;
+
+	if (event == PRESSED)
+	{
+		press_count++;
+	}
+
 	if (event == PRESSED && !both_btns_pressed)
 	{
 		extend_inactive_timer();
@@ -173,35 +1330,57 @@ static void process_key_event(enum key_event event, bool other_state, uint8_t bi
 	}
 	else if (event == RELEASED)
 	{
+		bool element_added = false;
+
 		extend_inactive_timer();
 		if (both_btns_pressed)
 		{
 			if (!other_state)
 			{
-				NRF_LOG_INFO("ALT KEY MODE");
+				EVENT_LOG(KEYBOARD_LOG_MODE, LOG_ALT_KEY_MODE, 0);
 				both_btns_pressed = false;
 				alt_key_mode = true;
 			}
 		}
+		else if (!key_repeat_mode && !classify_press(key, other))
+		{
+			rejected_press_count++;
+			last_release_time = key->release_time;
+			advance_count_active = (current_code_pos > 0) || alt_key_mode;
+			return;
+		}
 		else
 		{
 			current_code |= bit << current_code_pos;
 			current_code_pos++;
+			element_added = true;
 		}
+		last_release_time = key->release_time;
 
 		if (key_repeat_mode)
 		{
+			if (key_held)
+			{
+				send_key_release();
+				key_held = false;
+			}
+			if (repeat_key != 0)
+			{
+				stop_key_repeat_timer();
+				repeat_key = 0;
+			}
 			key_hold_count = 0;
 			key_repeat_mode = false;
-			current_code = 0;
-			current_code_pos = 0;
-			NRF_LOG_INFO("CODE RESET");
-			alt_key_mode = false;
+			reset_code();
 		}
 		else
 		{
 			advance_count = 0;
 			advance_count_active = true;
+			if (element_added)
+			{
+				process_partial_code();
+			}
 		}
 	}
 }
@@ -209,25 +1388,27 @@ static void process_key_event(enum key_event event, bool other_state, uint8_t bi
 
 void poll_keys(void)
 {
-	enum key_event power_event = debounce_key(&power_key, POWER_KEY_PIN);
+	poll_count++;
+
+	enum key_event power_event = debounce_key(&power_key, POWER_KEY);
 	if (power_event == RELEASED)
 	{
 		sleep_mode_enter(false);
 	}
 
-	enum key_event left_event = debounce_key(&left_key, LEFT_KEY_PIN);
-	process_key_event(left_event, right_key.state, 0);
+	enum key_event left_event = debounce_key(&left_key, LEFT_KEY);
+	process_key_event(left_event, &left_key, &right_key, 0);
 
-	enum key_event right_event = debounce_key(&right_key, RIGHT_KEY_PIN);
-	process_key_event(right_event, left_key.state, 1);
+	enum key_event right_event = debounce_key(&right_key, RIGHT_KEY);
+	process_key_event(right_event, &right_key, &left_key, 1);
 	
 	// key_hold counter
 	if (!key_repeat_mode && !both_btns_pressed && (left_key.state || right_key.state))
 	{
 		key_hold_count++;
-		if (key_hold_count > KEY_HOLD_TIME)
+		if (key_hold_count > timing.key_hold_time)
 		{
-			NRF_LOG_INFO("HOLD TRIGGERED");
+			EVENT_LOG(KEYBOARD_LOG_MODE, LOG_HOLD_TRIGGERED, 0);
 			advance_count_active = false;
 			key_repeat_mode = true;
 			key_hold_count = 0;
@@ -240,96 +1421,45 @@ void poll_keys(void)
 		}
 	}
 
-	// key_hold_repeat counter
-	if (key_repeat_mode)
-	{
-		key_hold_count++;
-		if (key_hold_count > KEY_REPEAT_TIME)
-		{
-			process_code();
-			key_hold_count = 0;
-		}
-	}
-
 	// code advance
 	if (advance_count_active)
 	{
 		advance_count++;
-		if (advance_count > ADVANCE_TIME)
+		if (advance_count > timing.advance_time)
 		{
 			process_code();
-			current_code = 0;
-			current_code_pos = 0;
-			NRF_LOG_INFO("CODE RESET");
-			alt_key_mode = false;
-			advance_count_active = false;
+			reset_code();
 		}
 	}
 }
 
 
-void set_device_state(enum device_state state)
-{
-	switch (state)
-	{
-	    case DISCONNECTED:
-			NRF_LOG_INFO("Event: DISCONNECTED");
-			start_led_flash_timer(pair_mode);
-			break;
-	    case CONNECTED:
-			NRF_LOG_INFO("Event: CONNECTED");
-			pair_mode = false;
-			stop_led_flash_timer();
-			nrf_gpio_pin_set(LED_PIN);
-			break;
-	    case SLEEP:
-			NRF_LOG_INFO("Event: SLEEP");
-			sleep_mode_enter(true);
-			break;
-	    case OFF:
-			NRF_LOG_INFO("Event: OFF");
-			sleep_mode_enter(false);
-			break;
-	}
-}
-
-	
-// Function for initializing keys, debouncing and leds
-void gpio_init(bool * p_whitelist_active, bool * p_clear_paired)
+// Function for initializing debouncing, the traces and the macros
+void keyboard_init(void)
 {
-	power_key.prev = false;
-	power_key.state = false;
-	nrf_gpio_cfg_input(POWER_KEY_PIN, NRF_GPIO_PIN_PULLUP);
+	key_reading_init(&power_key, POWER_KEY_PRESS_LOCKOUT, POWER_KEY_RELEASE_SAMPLES);
+	key_reading_init(&left_key, timing.left_press_lockout, timing.left_release_samples);
+	key_reading_init(&right_key, timing.right_press_lockout, timing.right_release_samples);
+	trace_init();
+	event_trace_init();
 
-	left_key.prev = false;
-	left_key.state = false;
-	nrf_gpio_cfg_input(LEFT_KEY_PIN, NRF_GPIO_PIN_PULLUP);
-	
-	right_key.prev = false;
-	right_key.state = false;
-	nrf_gpio_cfg_input(RIGHT_KEY_PIN, NRF_GPIO_PIN_PULLUP);
+	macros_init(default_macro_table, sizeof(default_macro_table));
+	reset_word();
+}
 
-	nrf_gpio_cfg_output(LED_PIN);
-	nrf_gpio_pin_set(LED_PIN); // set LED on at start to give some indication that the power button worked
 
-	NRF_LOG_INFO("BTN: %d %d %d", !nrf_gpio_pin_read(POWER_KEY_PIN), !nrf_gpio_pin_read(LEFT_KEY_PIN), !nrf_gpio_pin_read(RIGHT_KEY_PIN));
+void keyboard_get_timing(keyboard_timing_t * p_timing)
+{
+	*p_timing = timing;
+}
 
-	// check if pair mode
-	if(!nrf_gpio_pin_read(LEFT_KEY_PIN) || !nrf_gpio_pin_read(RIGHT_KEY_PIN))
-	{
-		*p_whitelist_active = false;
-		// if both buttons are pressed clear all paired devices
-		*p_clear_paired = !nrf_gpio_pin_read(LEFT_KEY_PIN) && !nrf_gpio_pin_read(RIGHT_KEY_PIN);
-		pair_mode = true;
-		NRF_LOG_INFO("PAIR MODE");
 
-		// wait for the buttons to be released
-		while (!nrf_gpio_pin_read(LEFT_KEY_PIN) || !nrf_gpio_pin_read(RIGHT_KEY_PIN));
-	}
-	else
-	{
-		*p_whitelist_active = true;
-		*p_clear_paired = false;
-		pair_mode = false;
-	}
+// change the decoder timing, the debounce settings apply to the left and right buttons from their next reading
+void keyboard_set_timing(keyboard_timing_t const * p_timing)
+{
+	timing = *p_timing;
+	left_key.press_lockout = timing.left_press_lockout;
+	left_key.release_samples = timing.left_release_samples;
+	right_key.press_lockout = timing.right_press_lockout;
+	right_key.release_samples = timing.right_release_samples;
 }
@@ -0,0 +1,290 @@
+// Generated by tools/make_keymap.py from keymap.txt, do not edit
+
+#ifndef KEYMAP_DATA_H
+#define KEYMAP_DATA_H
+
+#define KEY_TABLE_SIZE                   54
+#define ALT_KEY_TABLE_SIZE               22
+#define NUMERIC_KEY_TABLE_SIZE           14
+#define COMMAND_KEY_TABLE_SIZE           8
+#define KEY_TABLE_INDEX_SIZE             256
+#define ALT_KEY_TABLE_INDEX_SIZE         32
+#define NUMERIC_KEY_TABLE_INDEX_SIZE     16
+#define COMMAND_KEY_TABLE_INDEX_SIZE     32
+#define CORRECTION_MAX_CODE_SIZE         8
+#define CORRECTION_INDEX_SIZE            512
+
+static const uint16_t key_table[KEY_TABLE_SIZE][4] =
+{
+ {0b110,        KEY_A,            0,              CODE_SPECULATE }, // a
+ {0b10001,      KEY_B,            0,              CODE_SPECULATE }, // b
+ {0b10101,      KEY_C,            0,              CODE_SPECULATE }, // c
+ {0b1001,       KEY_D,            0,              CODE_SPECULATE }, // d
+ {0b10,         KEY_E,            0,              CODE_SPECULATE }, // e
+ {0b10100,      KEY_F,            0,              CODE_LEAF      }, // f
+ {0b1011,       KEY_G,            0,              CODE_SPECULATE }, // g
+ {0b10000,      KEY_H,            0,              CODE_SPECULATE }, // h
+ {0b100,        KEY_I,            0,              CODE_SPECULATE }, // i
+ {0b11110,      KEY_J,            0,              CODE_SPECULATE }, // j
+ {0b1101,       KEY_K,            0,              CODE_SPECULATE }, // k
+ {0b10010,      KEY_L,            0,              CODE_SPECULATE }, // l
+ {0b111,        KEY_M,            0,              CODE_SPECULATE }, // m
+ {0b101,        KEY_N,            0,              CODE_SPECULATE }, // n
+ {0b1111,       KEY_O,            0,              CODE_SPECULATE }, // o
+ {0b10110,      KEY_P,            0,              CODE_SPECULATE }, // p
+ {0b11011,      KEY_Q,            0,              CODE_LEAF      }, // q
+ {0b1010,       KEY_R,            0,              CODE_SPECULATE }, // r
+ {0b1000,       KEY_S,            0,              CODE_SPECULATE }, // s
+ {0b11,         KEY_T,            0,              CODE_SPECULATE }, // t
+ {0b1100,       KEY_U,            0,              CODE_SPECULATE }, // u
+ {0b11000,      KEY_V,            0,              CODE_SPECULATE }, // v
+ {0b1110,       KEY_W,            0,              CODE_SPECULATE }, // w
+ {0b11001,      KEY_X,            0,              CODE_SPECULATE }, // x
+ {0b11101,      KEY_Y,            0,              CODE_SPECULATE }, // y
+ {0b10011,      KEY_Z,            0,              CODE_SPECULATE }, // z
+ {0b111110,     KEY_1,            0,              CODE_SPECULATE }, // 1
+ {0b111100,     KEY_2,            0,              CODE_LEAF      }, // 2
+ {0b111000,     KEY_3,            0,              CODE_LEAF      }, // 3
+ {0b110000,     KEY_4,            0,              CODE_LEAF      }, // 4
+ {0b100000,     KEY_5,            0,              CODE_LEAF      }, // 5
+ {0b100001,     KEY_6,            0,              CODE_SPECULATE }, // 6
+ {0b100011,     KEY_7,            0,              CODE_LEAF      }, // 7
+ {0b100111,     KEY_8,            0,              CODE_SPECULATE }, // 8
+ {0b101111,     KEY_9,            0,              CODE_LEAF      }, // 9
+ {0b111111,     KEY_0,            0,              CODE_LEAF      }, // 0
+ {0b1101010,    KEY_DOT,          0,              CODE_LEAF      }, // .
+ {0b1110011,    KEY_COMMA,        0,              CODE_LEAF      }, // ,
+ {0b110101,     KEY_SEMICOLON,    0,              CODE_SPECULATE }, // ;
+ {0b101001,     KEY_SLASH,        0,              CODE_LEAF      }, // /
+ {0b1011110,    KEY_APOSTROPHE,   0,              CODE_LEAF      }, // '
+ {0b1100001,    KEY_MINUS,        0,              CODE_LEAF      }, // -
+ {0b110001,     KEY_EQUAL,        0,              CODE_LEAF      }, // =
+ {0b1001100,    KEY_SLASH,        KEY_MOD_LSHIFT, CODE_LEAF      }, // ?
+ {0b1000111,    KEY_SEMICOLON,    KEY_MOD_LSHIFT, CODE_LEAF      }, // :
+ {0b1101100,    KEY_MINUS,        KEY_MOD_LSHIFT, CODE_LEAF      }, // _
+ {0b101101,     KEY_9,            KEY_MOD_LSHIFT, CODE_SPECULATE }, // (
+ {0b1101101,    KEY_0,            KEY_MOD_LSHIFT, CODE_LEAF      }, // )
+ {0b1010110,    KEY_2,            KEY_MOD_LSHIFT, CODE_LEAF      }, // @
+ {0b1110101,    KEY_1,            KEY_MOD_LSHIFT, CODE_LEAF      }, // !
+ {0b100010,     KEY_7,            KEY_MOD_LSHIFT, CODE_LEAF      }, // &
+ {0b1010010,    KEY_APOSTROPHE,   KEY_MOD_LSHIFT, CODE_LEAF      }, // "
+ {0b101010,     KEY_EQUAL,        KEY_MOD_LSHIFT, CODE_SPECULATE }, // +
+ {0b11001000,   KEY_4,            KEY_MOD_LSHIFT, CODE_LEAF      }  // $
+};
+
+static const uint8_t key_table_index[KEY_TABLE_INDEX_SIZE] =
+{
+    0xff, 0xff, 0x04, 0x13, 0x08, 0x0d, 0x00, 0x0c, 0x12, 0x03, 0x11, 0x06, 0x14, 0x0a, 0x16, 0x0e,
+    0x07, 0x01, 0x0b, 0x19, 0x05, 0x02, 0x0f, 0xff, 0x15, 0x17, 0xff, 0x10, 0xff, 0x18, 0x09, 0xff,
+    0x1e, 0x1f, 0x32, 0x20, 0xff, 0xff, 0xff, 0x21, 0xff, 0x27, 0x34, 0xff, 0xff, 0x2e, 0xff, 0x22,
+    0x1d, 0x2a, 0xff, 0xff, 0xff, 0x26, 0xff, 0xff, 0x1c, 0xff, 0xff, 0xff, 0x1b, 0xff, 0x1a, 0x23,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x2c, 0xff, 0xff, 0xff, 0xff, 0x2b, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0x33, 0xff, 0xff, 0xff, 0x30, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x28, 0xff,
+    0xff, 0x29, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x24, 0xff, 0x2d, 0x2f, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0x25, 0xff, 0x31, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x35, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const uint8_t key_table_nearest[CORRECTION_INDEX_SIZE] =
+{
+    0xff, 0xff, 0x04, 0x13, 0x08, 0x0d, 0x00, 0x0c, 0x12, 0x03, 0x11, 0x06, 0x14, 0x0a, 0x16, 0x0e,
+    0x07, 0x01, 0x0b, 0x19, 0x05, 0x02, 0x0f, 0xff, 0x15, 0x17, 0xff, 0x10, 0xff, 0x18, 0x09, 0xff,
+    0x1e, 0x1f, 0x32, 0x20, 0xff, 0xff, 0xff, 0x21, 0xff, 0x27, 0x34, 0xff, 0xff, 0x2e, 0x09, 0x22,
+    0x1d, 0x2a, 0xff, 0xff, 0x05, 0x26, 0xff, 0x10, 0x1c, 0xff, 0xff, 0xff, 0x1b, 0xff, 0x1a, 0x23,
+    0x1e, 0xff, 0xff, 0xff, 0x32, 0x32, 0x20, 0x2c, 0x35, 0x27, 0x34, 0xff, 0x2b, 0x2e, 0x21, 0xff,
+    0x1d, 0x2a, 0x33, 0x27, 0x34, 0xff, 0x30, 0xff, 0x1c, 0xff, 0x2e, 0x2e, 0x1b, 0x09, 0x28, 0xff,
+    0xff, 0x29, 0xff, 0xff, 0x35, 0xff, 0xff, 0x21, 0xff, 0x27, 0x24, 0x26, 0x2d, 0x2f, 0xff, 0x22,
+    0xff, 0xff, 0xff, 0x25, 0x31, 0x31, 0xff, 0xff, 0xff, 0x1b, 0xff, 0xff, 0xff, 0x1a, 0xff, 0x23,
+    0x1e, 0x1e, 0x1f, 0x1f, 0x32, 0x32, 0x20, 0x2c, 0x35, 0xff, 0xff, 0xff, 0x2b, 0xff, 0x2c, 0x2c,
+    0x35, 0x35, 0x33, 0x27, 0x34, 0x34, 0x30, 0xff, 0x2b, 0x2b, 0x2e, 0x2e, 0xff, 0xff, 0x28, 0x22,
+    0x1d, 0x29, 0x2a, 0x2a, 0x33, 0x33, 0xff, 0xff, 0xff, 0xff, 0x24, 0x26, 0xff, 0xff, 0xff, 0xff,
+    0x1c, 0x1c, 0xff, 0x25, 0xff, 0x31, 0xff, 0xff, 0x1b, 0x1b, 0xff, 0xff, 0x28, 0x28, 0x23, 0x23,
+    0xff, 0x1e, 0x29, 0x29, 0x32, 0x32, 0x20, 0x2c, 0x35, 0x35, 0x35, 0xff, 0x2b, 0xff, 0x21, 0x21,
+    0xff, 0xff, 0x33, 0x27, 0x24, 0x24, 0x30, 0xff, 0x2d, 0x2d, 0x2f, 0x2f, 0xff, 0xff, 0x28, 0x22,
+    0x1d, 0x29, 0x2a, 0x2a, 0x35, 0xff, 0x25, 0x25, 0x35, 0xff, 0xff, 0x31, 0x2d, 0x2f, 0xff, 0xff,
+    0x1c, 0x1c, 0xff, 0x25, 0xff, 0x31, 0xff, 0xff, 0x1b, 0x1b, 0xff, 0xff, 0x1a, 0x1a, 0x23, 0x23,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x2c, 0x2c,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x2b, 0x2b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0x33, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x30, 0x30, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x28, 0x28, 0xff, 0xff,
+    0xff, 0xff, 0x29, 0x29, 0xff, 0xff, 0xff, 0xff, 0x35, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0x24, 0x24, 0xff, 0xff, 0x2d, 0x2d, 0x2f, 0x2f, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x25, 0x25, 0xff, 0xff, 0x31, 0x31, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x2c, 0x2c,
+    0x35, 0x35, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x2b, 0x2b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0x33, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x30, 0x30, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x28, 0x28, 0xff, 0xff,
+    0xff, 0xff, 0x29, 0x29, 0xff, 0xff, 0xff, 0xff, 0x35, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0x24, 0x24, 0xff, 0xff, 0x2d, 0x2d, 0x2f, 0x2f, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x25, 0x25, 0xff, 0xff, 0x31, 0x31, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const uint16_t alt_key_table[ALT_KEY_TABLE_SIZE][4] =
+{
+ {0b10,         KEY_SPACE,        0,              CODE_WAIT      }, // space
+ {0b100,        KEY_ENTER,        0,              CODE_WAIT      }, // enter
+ {0b11,         KEY_BACKSPACE,    0,              CODE_WAIT      }, // backspace
+ {0b1110,       KEY_LEFT,         0,              CODE_WAIT      }, // move left
+ {0b11110,      KEY_RIGHT,        0,              CODE_LEAF      }, // move right
+ {0b110,        FN_MOD_SHIFT,     0,              CODE_WAIT      }, // shift
+ {0b111,        KEY_ESC,          0,              CODE_WAIT      }, // escape
+ {0b101,        FN_COMPLETE_WORD, 0,              CODE_WAIT      }, // complete word
+ {0b1010,       FN_NUMERIC_LAYER, 0,              CODE_LEAF      }, // numeric layer on/off
+ {0b10110,      FN_ABBREVIATION_TOGGLE, 0,              CODE_LEAF      }, // abbreviations on/off
+ {0b1111,       FN_CALCULATOR,    0,              CODE_WAIT      }, // calculator
+ {0b11111,      FN_COMPOSE,       0,              CODE_LEAF      }, // compose line / send line
+ {0b10111,      FN_COMMAND,       0,              CODE_LEAF      }, // device command
+ {0b1101,       FN_MOD_CTRL,      0,              CODE_LEAF      }, // ctrl
+ {0b1001,       FN_MOD_ALT,       0,              CODE_WAIT      }, // alt
+ {0b1011,       FN_MOD_GUI,       0,              CODE_LEAF      }, // gui (windows / command key)
+ {0b1000,       KEY_BACKSPACE,    KEY_MOD_LCTRL,  CODE_WAIT      }, // delete word
+ {0b11000,      KEY_LEFT,         KEY_MOD_LCTRL | KEY_MOD_LSHIFT, CODE_LEAF      }, // select word
+ {0b1100,       KEY_Z,            KEY_MOD_LCTRL,  CODE_WAIT      }, // undo
+ {0b11100,      KEY_X,            KEY_MOD_LCTRL,  CODE_LEAF      }, // cut
+ {0b10001,      KEY_C,            KEY_MOD_LCTRL,  CODE_LEAF      }, // copy
+ {0b11001,      KEY_V,            KEY_MOD_LCTRL,  CODE_LEAF      }  // paste
+};
+
+static const uint8_t alt_key_table_index[ALT_KEY_TABLE_INDEX_SIZE] =
+{
+    0xff, 0xff, 0x00, 0x02, 0x01, 0x07, 0x05, 0x06, 0x10, 0x0e, 0x08, 0x0f, 0x12, 0x0d, 0x03, 0x0a,
+    0xff, 0x14, 0xff, 0xff, 0xff, 0xff, 0x09, 0x0c, 0x11, 0x15, 0xff, 0xff, 0x13, 0xff, 0x04, 0x0b,
+};
+
+static const uint8_t alt_key_table_nearest[CORRECTION_INDEX_SIZE] =
+{
+    0xff, 0xff, 0x00, 0x02, 0x01, 0x07, 0x05, 0x06, 0x10, 0x0e, 0x08, 0x0f, 0x12, 0x0d, 0x03, 0x0a,
+    0x10, 0x14, 0xff, 0xff, 0xff, 0xff, 0x09, 0x0c, 0x11, 0x15, 0xff, 0xff, 0x13, 0xff, 0x04, 0x0b,
+    0x10, 0x14, 0x14, 0x14, 0x08, 0x08, 0x09, 0x0c, 0x11, 0x15, 0x0d, 0x0d, 0xff, 0x09, 0xff, 0xff,
+    0x11, 0xff, 0x15, 0x15, 0x08, 0x08, 0x09, 0x0c, 0xff, 0xff, 0x0d, 0x0d, 0xff, 0x04, 0xff, 0x0b,
+    0xff, 0xff, 0x14, 0x14, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x09, 0x09, 0x0c, 0x0c,
+    0x11, 0x11, 0x15, 0x15, 0xff, 0xff, 0xff, 0xff, 0x13, 0x13, 0xff, 0xff, 0x04, 0x04, 0x0b, 0x0b,
+    0xff, 0xff, 0x14, 0x14, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x09, 0x09, 0x0c, 0x0c,
+    0x11, 0x11, 0x15, 0x15, 0xff, 0xff, 0xff, 0xff, 0x13, 0x13, 0xff, 0xff, 0x04, 0x04, 0x0b, 0x0b,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const uint16_t numeric_key_table[NUMERIC_KEY_TABLE_SIZE][4] =
+{
+ {0b10,         KEY_1,            0,              CODE_SPECULATE }, // 1
+ {0b11,         KEY_0,            0,              CODE_SPECULATE }, // 0
+ {0b100,        KEY_2,            0,              CODE_SPECULATE }, // 2
+ {0b110,        KEY_3,            0,              CODE_SPECULATE }, // 3
+ {0b101,        KEY_4,            0,              CODE_SPECULATE }, // 4
+ {0b111,        KEY_5,            0,              CODE_SPECULATE }, // 5
+ {0b1000,       KEY_6,            0,              CODE_LEAF      }, // 6
+ {0b1100,       KEY_7,            0,              CODE_LEAF      }, // 7
+ {0b1010,       KEY_8,            0,              CODE_LEAF      }, // 8
+ {0b1110,       KEY_9,            0,              CODE_LEAF      }, // 9
+ {0b1001,       KEY_DOT,          0,              CODE_LEAF      }, // .
+ {0b1101,       KEY_ENTER,        0,              CODE_LEAF      }, // enter (also ends the numeric layer)
+ {0b1011,       KEY_SPACE,        0,              CODE_LEAF      }, // space
+ {0b1111,       KEY_MINUS,        0,              CODE_LEAF      }  // -
+};
+
+static const uint8_t numeric_key_table_index[NUMERIC_KEY_TABLE_INDEX_SIZE] =
+{
+    0xff, 0xff, 0x00, 0x01, 0x02, 0x04, 0x03, 0x05, 0x06, 0x0a, 0x08, 0x0c, 0x07, 0x0b, 0x09, 0x0d,
+};
+
+static const uint8_t numeric_key_table_nearest[CORRECTION_INDEX_SIZE] =
+{
+    0xff, 0xff, 0x00, 0x01, 0x02, 0x04, 0x03, 0x05, 0x06, 0x0a, 0x08, 0x0c, 0x07, 0x0b, 0x09, 0x0d,
+    0x06, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0d,
+    0x06, 0x06, 0x0a, 0x0a, 0x08, 0x08, 0x0c, 0x0c, 0x07, 0x07, 0x0b, 0x0b, 0x09, 0x09, 0x0d, 0x0d,
+    0x06, 0x06, 0x0a, 0x0a, 0x08, 0x08, 0x0c, 0x0c, 0x07, 0x07, 0x0b, 0x0b, 0x09, 0x09, 0x0d, 0x0d,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const uint16_t command_key_table[COMMAND_KEY_TABLE_SIZE][4] =
+{
+ {0b10110,      FN_CMD_PAIR,      0,              CODE_LEAF      }, // P: pair
+ {0b101,        FN_CMD_NEXT_PEER, 0,              CODE_WAIT      }, // N: next device
+ {0b10001,      FN_CMD_BATTERY,   0,              CODE_LEAF      }, // B: battery level
+ {0b10010,      FN_CMD_POWER_PROFILE, 0,              CODE_LEAF      }, // L: low power on/off
+ {0b100,        FN_CMD_INPUT_MODE, 0,              CODE_WAIT      }, // I: input mode
+ {0b1111,       FN_CMD_OFF,       0,              CODE_LEAF      }, // O: off
+ {0b11,         FN_CMD_TRACE,     0,              CODE_WAIT      }, // T: dump the press trace
+ {0b1000,       FN_CMD_AUTO_SPACE, 0,              CODE_LEAF      }  // S: space after punctuation on/off
+};
+
+static const uint8_t command_key_table_index[COMMAND_KEY_TABLE_INDEX_SIZE] =
+{
+    0xff, 0xff, 0xff, 0x06, 0x04, 0x01, 0xff, 0xff, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x05,
+    0xff, 0x02, 0x03, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const uint8_t default_macro_table[] =
+{
+ MACRO_CODE(0b10100), 2,                                                               // FL (alt ..-.)
+   KEY_MOD_LSHIFT, KEY_F,  KEY_MOD_LSHIFT, KEY_L,
+ MACRO_CODE(0b10000), 3,                                                               // HDG (alt ....)
+   KEY_MOD_LSHIFT, KEY_H,  KEY_MOD_LSHIFT, KEY_D,  KEY_MOD_LSHIFT, KEY_G,
+ MACRO_CODE(0b11011), 3,                                                               // QNH (alt --.-)
+   KEY_MOD_LSHIFT, KEY_Q,  KEY_MOD_LSHIFT, KEY_N,  KEY_MOD_LSHIFT, KEY_H,
+ MACRO_CODE(0b10101), 4,                                                               // CLRD (alt -.-.)
+   KEY_MOD_LSHIFT, KEY_C,  KEY_MOD_LSHIFT, KEY_L,  KEY_MOD_LSHIFT, KEY_R,  KEY_MOD_LSHIFT, KEY_D,
+ MACRO_CODE(0b111110), 5,                                                              // 121.5 (alt .----)
+   0, KEY_1,  0, KEY_2,  0, KEY_1,  0, KEY_DOT,  0, KEY_5,
+};
+
+#endif // KEYMAP_DATA_H
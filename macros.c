@@ -0,0 +1,342 @@
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "fds.h"
+
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_default_backends.h"
+
+#include "common.h"
+
+#define MACRO_FILE_ID                       0x4D41        // FDS file holding the uploaded macros
+#define MACRO_RECORD_KEY                    0x0001        // FDS record holding the uploaded macros
+#define MACRO_STORAGE_SIZE                  256           // largest macro set that can be uploaded (in bytes)
+
+// Macro upload commands, sent as the first byte of a feature report
+#define MACRO_UPLOAD_BEGIN                  0x01          // start a new macro set
+#define MACRO_UPLOAD_DATA                   0x02          // append the second byte to the macro set
+#define MACRO_UPLOAD_COMMIT                 0x03          // check the macro set, save it to flash and start using it
+#define MACRO_UPLOAD_RESET                  0x04          // delete the uploaded macro set and go back to the defaults
+
+/*
+ * Macro set format, one entry after another:
+ * [1] key sequence as 2 bytes (low byte first), in the same form as the code tables
+ * [2] number of keys
+ * [3] modifier byte and key code for each key
+ */
+
+// Macros in use, either the defaults or a copy of the uploaded set
+static uint8_t const * p_macros = NULL;
+static uint16_t macros_len = 0;
+
+static uint32_t macro_storage[MACRO_STORAGE_SIZE / 4];      // uploaded macro set loaded from flash
+static uint32_t upload_buffer[MACRO_STORAGE_SIZE / 4];      // macro set being uploaded, must stay valid until it is written
+static uint16_t upload_len = 0;
+static bool save_pending = false;                           // upload waiting for garbage collection to free flash
+static bool save_in_flight = false;                         // upload_buffer is being written, uploads are refused
+static bool upload_open = false;                            // begun and not refused since, data can be added
+
+static uint8_t const * p_default_macros = NULL;
+static uint16_t default_macros_len = 0;
+
+
+// check that every entry in a macro set is complete
+static bool macros_valid(uint8_t const * p_data, uint16_t len)
+{
+	uint16_t pos = 0;
+
+	while (pos < len)
+	{
+		if ((pos + 3) > len)
+		{
+			return false;
+		}
+		uint8_t count = p_data[pos + 2];
+		// a macro is sent as one burst, so it can't be longer than the report backlog
+		if ((count == 0) || (count > SEND_KEYS_MAX) || ((pos + 3 + (count * 2)) > len))
+		{
+			return false;
+		}
+		pos += 3 + (count * 2);
+	}
+	return true;
+}
+
+
+// load the uploaded macro set from flash, or use the defaults if there isn't one
+static void macros_load(void)
+{
+	fds_record_desc_t desc;
+	fds_find_token_t  token;
+	fds_flash_record_t record;
+
+	memset(&token, 0, sizeof(token));
+
+	p_macros = p_default_macros;
+	macros_len = default_macros_len;
+
+	if (fds_record_find(MACRO_FILE_ID, MACRO_RECORD_KEY, &desc, &token) == NRF_SUCCESS)
+	{
+		if (fds_record_open(&desc, &record) == NRF_SUCCESS)
+		{
+			uint8_t const * p_data = record.p_data;
+			uint16_t len = p_data[0] | (p_data[1] << 8);
+
+			if (((len + 2) <= (record.p_header->length_words * 4)) &&
+				(len <= sizeof(macro_storage)) &&
+				macros_valid(p_data + 2, len))
+			{
+				memcpy(macro_storage, p_data + 2, len);
+				p_macros = (uint8_t const *)macro_storage;
+				macros_len = len;
+				NRF_LOG_INFO("Loaded %d bytes of macros", len);
+			}
+			UNUSED_RETURN_VALUE(fds_record_close(&desc));
+		}
+	}
+}
+
+
+// write the uploaded macro set to flash, replacing any earlier one, garbage is only collected
+// once for each upload so a set that still doesn't fit fails rather than collecting again
+static void macros_save(bool after_gc)
+{
+	ret_code_t err_code;
+	fds_record_desc_t desc;
+	fds_find_token_t  token;
+	fds_record_t record;
+
+	memset(&token, 0, sizeof(token));
+
+	record.file_id           = MACRO_FILE_ID;
+	record.key               = MACRO_RECORD_KEY;
+	record.data.p_data       = upload_buffer;
+	record.data.length_words = (upload_len + 2 + 3) / 4;
+
+	// set before the write starts, its completion event clears it
+	save_in_flight = true;
+	if (fds_record_find(MACRO_FILE_ID, MACRO_RECORD_KEY, &desc, &token) == NRF_SUCCESS)
+	{
+		err_code = fds_record_update(&desc, &record);
+	}
+	else
+	{
+		err_code = fds_record_write(NULL, &record);
+	}
+
+	if ((err_code == FDS_ERR_NO_SPACE_IN_FLASH) && !after_gc)
+	{
+		// free the space used by old records, the save is retried once garbage collection completes
+		NRF_LOG_INFO("Macro storage full, collecting garbage");
+		save_pending = true;
+		if (fds_gc() != NRF_SUCCESS)
+		{
+			save_pending = false;
+			save_in_flight = false;
+			NRF_LOG_INFO("Macro save failed: garbage collection not started");
+		}
+	}
+	else if (err_code != NRF_SUCCESS)
+	{
+		save_in_flight = false;
+		NRF_LOG_INFO("Macro save failed: %d", err_code);
+	}
+}
+
+
+// delete the uploaded macro set so that the defaults are used
+static void macros_delete(void)
+{
+	fds_record_desc_t desc;
+	fds_find_token_t  token;
+
+	memset(&token, 0, sizeof(token));
+
+	if (fds_record_find(MACRO_FILE_ID, MACRO_RECORD_KEY, &desc, &token) == NRF_SUCCESS)
+	{
+		UNUSED_RETURN_VALUE(fds_record_delete(&desc));
+	}
+}
+
+
+static void fds_evt_handler(fds_evt_t const * p_evt)
+{
+	switch (p_evt->id)
+	{
+	    case FDS_EVT_INIT:
+			if (p_evt->result == NRF_SUCCESS)
+			{
+				macros_load();
+			}
+			break;
+	    case FDS_EVT_WRITE:
+	    case FDS_EVT_UPDATE:
+			if (p_evt->write.file_id == MACRO_FILE_ID)
+			{
+				save_in_flight = false;
+				if (p_evt->result == NRF_SUCCESS)
+				{
+					NRF_LOG_INFO("Macros saved");
+					macros_load();
+				}
+				else
+				{
+					NRF_LOG_INFO("Macro save failed: %d", p_evt->result);
+				}
+			}
+			break;
+	    case FDS_EVT_DEL_RECORD:
+			if ((p_evt->result == NRF_SUCCESS) && (p_evt->del.file_id == MACRO_FILE_ID))
+			{
+				NRF_LOG_INFO("Macros reset to defaults");
+				macros_load();
+			}
+			break;
+	    case FDS_EVT_GC:
+			if (save_pending)
+			{
+				save_pending = false;
+				if (p_evt->result == NRF_SUCCESS)
+				{
+					macros_save(true);
+				}
+				else
+				{
+					save_in_flight = false;
+					NRF_LOG_INFO("Macro save failed: %d", p_evt->result);
+				}
+			}
+			break;
+	    default:
+			break;
+	}
+}
+
+
+/**@brief Function for handling a macro upload feature report.
+ *
+ * @param[in]   p_data   Feature report data, a command and a data byte.
+ * @param[in]   len      Length of the feature report.
+ */
+void macro_upload_write(uint8_t const * p_data, uint16_t len)
+{
+	uint8_t * p_upload = (uint8_t *)upload_buffer;
+
+	if (len < 2)
+	{
+		return;
+	}
+
+	// the buffer can't change until flash storage has written it, an upload cut short by this
+	// has to begin again
+	if (save_in_flight && (p_data[0] != MACRO_UPLOAD_RESET))
+	{
+		upload_open = false;
+		NRF_LOG_INFO("Macro upload refused: save in progress");
+		return;
+	}
+
+	switch (p_data[0])
+	{
+	    case MACRO_UPLOAD_BEGIN:
+			upload_len = 0;
+			upload_open = true;
+			break;
+	    case MACRO_UPLOAD_DATA:
+			if (upload_open && ((size_t)(upload_len + 2) < sizeof(upload_buffer)))
+			{
+				p_upload[upload_len + 2] = p_data[1];
+				upload_len++;
+			}
+			break;
+	    case MACRO_UPLOAD_COMMIT:
+			if (upload_open && macros_valid(p_upload + 2, upload_len))
+			{
+				upload_open = false;
+				p_upload[0] = upload_len & 0xFF;
+				p_upload[1] = upload_len >> 8;
+				macros_save(false);
+			}
+			else
+			{
+				NRF_LOG_INFO("Macro upload rejected");
+			}
+			break;
+	    case MACRO_UPLOAD_RESET:
+			macros_delete();
+			break;
+	}
+}
+
+
+/**@brief Function for finding the macro for a code.
+ *
+ * @param[in]   code      Code entered, in the same form as the code tables.
+ * @param[out]  pp_keys   Modifier byte and key code for each key in the macro.
+ * @param[out]  p_count   Number of keys in the macro.
+ *
+ * @return      true if there is a macro for the code.
+ */
+bool macro_find(uint16_t code, uint8_t const ** pp_keys, uint8_t * p_count)
+{
+	uint16_t pos = 0;
+
+	while (pos < macros_len)
+	{
+		uint16_t macro_code = p_macros[pos] | (p_macros[pos + 1] << 8);
+		uint8_t count = p_macros[pos + 2];
+
+		if (macro_code == code)
+		{
+			*pp_keys = &p_macros[pos + 3];
+			*p_count = count;
+			return true;
+		}
+		pos += 3 + (count * 2);
+	}
+	return false;
+}
+
+
+// check if a longer macro code starts with a code
+bool macro_is_prefix(uint16_t code)
+{
+	uint16_t pos = 0;
+	uint8_t code_len = 0;
+
+	while ((code >> code_len) > 1)
+	{
+		code_len++;
+	}
+	uint16_t mask = (1 << code_len) - 1;
+
+	while (pos < macros_len)
+	{
+		uint16_t macro_code = p_macros[pos] | (p_macros[pos + 1] << 8);
+
+		if (((macro_code >> code_len) > 1) && ((macro_code & mask) == (code & mask)))
+		{
+			return true;
+		}
+		pos += 3 + (p_macros[pos + 2] * 2);
+	}
+	return false;
+}
+
+
+// Function for initializing macros, must be called before the flash storage is initialized
+void macros_init(uint8_t const * p_defaults, uint16_t defaults_len)
+{
+	ret_code_t err_code;
+
+	p_default_macros = p_defaults;
+	default_macros_len = defaults_len;
+	p_macros = p_defaults;
+	macros_len = defaults_len;
+
+	err_code = fds_register(fds_evt_handler);
+	APP_ERROR_CHECK(err_code);
+}
@@ -126,12 +126,17 @@ static void power_management_init(void)
 
 /**@brief Function for handling the idle state (main loop).
  *
- * @details If there is no pending log operation, then sleep until next the next event occurs.
+ * @details If there is no pending log operation, then sleep until next the next event occurs. The
+ *          log messages recorded as events by the timer handlers are passed to the logger one at a
+ *          time here (see event_trace.c), with the logger off both are compiled out.
  */
 static void idle_state_handle(void)
 {
+    bool log_pending;
+
     app_sched_execute();
-    if (NRF_LOG_PROCESS() == false)
+    log_pending = NRF_MODULE_ENABLED(NRF_LOG) && event_log_process();
+    if ((NRF_LOG_PROCESS() == false) && !log_pending)
     {
         nrf_pwr_mgmt_run();
     }
@@ -147,6 +152,7 @@ int main(void)
     // Initialize.
     log_init();
     gpio_init(&whitelist_active, &clear_paired);
+    keyboard_init();
     power_management_init();
     scheduler_init();
 	bluetooth_init();
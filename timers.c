@@ -11,6 +11,7 @@
 #include "nrf_log_default_backends.h"
 
 #include "common.h"
+#include "hid_reports.h"
 
 #define BTN_POLL_INTERVAL                   APP_TIMER_TICKS(10)           // Poll each button every 10ms
 #define LED_BLINK_INTERVAL                  APP_TIMER_TICKS(700)          // Advertising mode flash time
@@ -24,6 +25,7 @@ APP_TIMER_DEF(m_battery_timer_id);      // Battery Level Measure Timer
 APP_TIMER_DEF(m_btn_poll_timer_id);     // Poll buttons for changes
 APP_TIMER_DEF(m_led_blink_timer_id);    // Flashing LED toggle timer
 APP_TIMER_DEF(m_inactive_timer_id);     // Inactive sleep timer
+APP_TIMER_DEF(m_key_repeat_timer_id);   // Time until the held key is next repeated
 
 
 // reset the count down until the sleep timer is triggered
@@ -58,6 +60,16 @@ static void btn_poll_timeout_handler(void * p_context)
 {
     UNUSED_PARAMETER(p_context);
 	poll_keys();
+	hid_reports_poll();
+	trace_poll();
+	event_trace_poll();
+}
+
+
+static void key_repeat_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+	key_repeat();
 }
 
 
@@ -92,6 +104,23 @@ void stop_led_flash_timer(void)
 }
 
 
+// repeat the held key after a time in ms
+void start_key_repeat_timer(uint32_t time)
+{
+    ret_code_t err_code;
+	err_code = app_timer_start(m_key_repeat_timer_id, APP_TIMER_TICKS(time), NULL);
+	APP_ERROR_CHECK(err_code);
+}
+
+
+void stop_key_repeat_timer(void)
+{
+    ret_code_t err_code;
+	err_code = app_timer_stop(m_key_repeat_timer_id);
+	APP_ERROR_CHECK(err_code);
+}
+
+
 void timers_start(void)
 {
     ret_code_t err_code;
@@ -131,4 +160,8 @@ void timers_init(void)
 	err_code = app_timer_create(&m_inactive_timer_id,
 								APP_TIMER_MODE_REPEATED, inactive_timeout_handler);
     APP_ERROR_CHECK(err_code);
+
+	err_code = app_timer_create(&m_key_repeat_timer_id,
+								APP_TIMER_MODE_SINGLE_SHOT, key_repeat_timeout_handler);
+    APP_ERROR_CHECK(err_code);
 }
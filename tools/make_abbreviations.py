@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""
+Build the abbreviation table used by abbreviations.c.
+
+Each line of the list is an abbreviation and its expansion ('#' for comments). The output is an
+open addressed hash table (linear probing) of offsets into a block of null terminated strings,
+so a lookup reads a slot or two from flash. The hash must match abbreviation_hash().
+
+usage: make_abbreviations.py abbreviations.txt > abbreviations_data.h
+"""
+
+import sys
+
+MAX_WORD_LEN = 16
+MAX_EXPANSION = 24     # ABBREVIATION_MAX_EXPANSION in common.h
+ALLOWED = set("abcdefghijklmnopqrstuvwxyz0123456789")
+EMPTY = 0xFFFF
+
+
+def abbreviation_hash(word):
+    # 32 bit FNV-1a
+    h = 0x811C9DC5
+    for c in word:
+        h ^= ord(c)
+        h = (h * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+
+    entries = {}
+    with open(sys.argv[1]) as f:
+        for line in f:
+            line = line.strip().lower()
+            if not line or line.startswith("#"):
+                continue
+            abbreviation, _, expansion = line.partition(" ")
+            expansion = expansion.strip()
+            if not expansion or len(abbreviation) > MAX_WORD_LEN or not set(abbreviation) <= ALLOWED:
+                sys.exit("invalid abbreviation: %r" % line)
+            if len(expansion) > MAX_EXPANSION or not set(expansion) <= ALLOWED | {" "}:
+                sys.exit("invalid expansion: %r" % line)
+            if abbreviation in entries:
+                sys.exit("duplicate abbreviation: %r" % abbreviation)
+            entries[abbreviation] = expansion
+
+    size = 4
+    while size < 2 * len(entries):
+        size *= 2
+
+    strings = bytearray()
+    slots = [(EMPTY, EMPTY)] * size
+    for abbreviation, expansion in entries.items():
+        a = len(strings)
+        strings += abbreviation.encode() + b"\0"
+        e = len(strings)
+        strings += expansion.encode() + b"\0"
+        i = abbreviation_hash(abbreviation) & (size - 1)
+        while slots[i][0] != EMPTY:
+            i = (i + 1) & (size - 1)
+        slots[i] = (a, e)
+
+    if len(strings) >= EMPTY:
+        sys.exit("abbreviations too large")
+
+    print("// Generated by tools/make_abbreviations.py from abbreviations.txt, do not edit")
+    print("// %d abbreviations, %d slots, %d bytes of strings" % (len(entries), size, len(strings)))
+    print()
+    print("#ifndef ABBREVIATIONS_DATA_H")
+    print("#define ABBREVIATIONS_DATA_H")
+    print()
+    print("#define ABBREVIATION_MAX_WORD_LEN  %d" % MAX_WORD_LEN)
+    print("#define ABBREVIATION_TABLE_SIZE    %d" % size)
+    print("#define ABBREVIATION_EMPTY         0x%04X" % EMPTY)
+    print()
+    print("// offsets of the abbreviation and its expansion in abbreviation_strings")
+    print("static const uint16_t abbreviation_table[ABBREVIATION_TABLE_SIZE][2] =")
+    print("{")
+    for a, e in slots:
+        print("    {0x%04X, 0x%04X}," % (a, e))
+    print("};")
+    print()
+    print("static const char abbreviation_strings[%d] =" % len(strings))
+    print("{")
+    for i in range(0, len(strings), 16):
+        print("    " + ", ".join("0x%02x" % b for b in strings[i:i + 16]) + ",")
+    print("};")
+    print()
+    print("#endif // ABBREVIATIONS_DATA_H")
+
+
+if __name__ == "__main__":
+    main()
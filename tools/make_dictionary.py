@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+Build the word completion dictionary used by dictionary.c.
+
+The word list (one word per line, most likely words first, '#' for comments) is turned into a
+DAWG: a trie where identical branches are stored once. Each node is laid out as
+
+  [0]    bit 7 set if a word ends at the node, bits 0-6 number of children
+  [1]    child to follow for the best completion, or 0xFF if the best completion ends here
+  [2..]  3 bytes per child: character, then the offset of the child node (low byte first)
+
+The root node is at offset 0.
+
+usage: make_dictionary.py dictionary.txt > dictionary_data.h
+"""
+
+import sys
+
+MAX_WORD_LEN = 24
+ALLOWED = set("abcdefghijklmnopqrstuvwxyz0123456789")
+
+
+class Node:
+    def __init__(self):
+        self.children = {}
+        self.terminal = False
+        self.score = 0      # score of the word ending at this node
+        self.weight = 0     # best score in this branch
+        self.best = 0xFF
+
+
+def read_words(path):
+    words = []
+    seen = set()
+    with open(path) as f:
+        for line in f:
+            word = line.strip().lower()
+            if not word or word.startswith("#"):
+                continue
+            if len(word) > MAX_WORD_LEN or not set(word) <= ALLOWED:
+                sys.exit("invalid word: %r" % word)
+            if word not in seen:
+                seen.add(word)
+                words.append(word)
+    return words
+
+
+def build_trie(words):
+    root = Node()
+    for rank, word in enumerate(words):
+        node = root
+        for c in word:
+            node = node.children.setdefault(c, Node())
+        node.terminal = True
+        node.score = len(words) - rank
+    return root
+
+
+def choose_best(node):
+    node.weight = node.score if node.terminal else 0
+    node.best = 0xFF
+    for i, c in enumerate(sorted(node.children)):
+        child = node.children[c]
+        choose_best(child)
+        if child.weight > node.weight:
+            node.weight = child.weight
+            node.best = i
+
+
+def merge(node, unique):
+    # identical branches (same words below and same best completions) are stored once
+    children = tuple((c, merge(node.children[c], unique)) for c in sorted(node.children))
+    key = (node.terminal, node.best, tuple((c, id(n)) for c, n in children))
+    if key not in unique:
+        node.children = dict(children)
+        unique[key] = node
+    return unique[key]
+
+
+def layout(root):
+    order = []
+    offsets = {}
+    pending = [root]
+    pos = 0
+    while pending:
+        node = pending.pop(0)
+        if id(node) in offsets:
+            continue
+        offsets[id(node)] = pos
+        order.append(node)
+        pos += 2 + 3 * len(node.children)
+        pending.extend(node.children[c] for c in sorted(node.children))
+    if pos > 0xFFFF:
+        sys.exit("dictionary too large: %d bytes" % pos)
+    return order, offsets, pos
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+
+    words = read_words(sys.argv[1])
+    root = build_trie(words)
+    choose_best(root)
+    root = merge(root, {})
+    order, offsets, size = layout(root)
+
+    data = []
+    for node in order:
+        if len(node.children) > 0x7F:
+            sys.exit("too many children in one node")
+        data.append((0x80 if node.terminal else 0) | len(node.children))
+        data.append(node.best)
+        for c in sorted(node.children):
+            offset = offsets[id(node.children[c])]
+            data.extend([ord(c), offset & 0xFF, offset >> 8])
+
+    print("// Generated by tools/make_dictionary.py from dictionary.txt, do not edit")
+    print("// %d words, %d nodes, %d bytes" % (len(words), len(order), size))
+    print()
+    print("#ifndef DICTIONARY_DATA_H")
+    print("#define DICTIONARY_DATA_H")
+    print()
+    print("#define DICTIONARY_MAX_WORD_LEN  %d" % MAX_WORD_LEN)
+    print()
+    print("static const uint8_t dictionary_data[%d] =" % size)
+    print("{")
+    for i in range(0, len(data), 16):
+        print("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    print("};")
+    print()
+    print("#endif // DICTIONARY_DATA_H")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,374 @@
+#!/usr/bin/env python3
+"""
+Build the code tables used by keyboard.c from the keymap.
+
+The keymap (keymap.txt) lists each table's codes in dots and dashes with the key they type, see
+the top of keymap.txt for the format. The output has for each table:
+
+  <TABLE>_SIZE          number of entries
+  <table>[]             code, key or device function, modifiers and how the code is sent, in flash
+  <TABLE>_INDEX_SIZE    1 << (longest code + 1)
+  <table>_index[]       entry for every code (with its end marker bit), CODE_NO_ENTRY if none
+  <table>_nearest[]     for the tables that are corrected, the nearest entry for every code up to
+                        CORRECTION_MAX_CODE_SIZE long, CODE_NO_ENTRY if there isn't a clear one
+
+and the default macros. How a code is sent is worked out from the other codes in its table: a
+code no longer code starts with is a CODE_LEAF, the rest wait or are sent speculatively as the
+keymap says.
+
+The keymap is checked, and nothing is written if any of these are found: a duplicate code in a
+table, a code longer than MAX_CODE_SIZE, a default macro on a code of the alt table, an unknown
+key, device function or modifier. The space left in each table (codes up to 4 elements long that
+aren't used) and the flash used are reported on stderr.
+
+usage: make_keymap.py keymap.txt > keymap_data.h
+"""
+
+import os
+import re
+import sys
+
+MAX_CODE_SIZE = 10             # MAX_CODE_SIZE in keyboard.c
+SEND_KEYS_MAX = 128            # SEND_KEYS_MAX in common.h, the longest macro that can be sent
+SHORT_CODE_SIZE = 4            # unused codes up to this long are reported
+NO_ENTRY = 0xFF                # CODE_NO_ENTRY in codes.h
+
+# Correction of codes that are not in a table, the entered code is matched to the nearest table code
+CORRECTED_LAYERS = ("standard", "alt", "numeric")
+CORRECTION_MAX_CODE_SIZE = 8   # longest entered code that will be corrected
+CORRECTION_MAX_COST = 2        # furthest an entered code can be from a table code and still be corrected
+CORRECTION_MIN_MARGIN = 1      # how much nearer the closest table code must be than the next closest
+
+# cost of each difference between an entered code and a table code
+EDIT_COST_END = 1              # an extra or missing element at the start or end (a split or merged press)
+EDIT_COST_MIDDLE = 3           # an extra or missing element inside the code
+EDIT_COST_SUBSTITUTE = 2       # the wrong button pressed
+
+# layer name, table name, size define
+LAYERS = [
+    ("standard", "key_table", "KEY_TABLE"),
+    ("alt", "alt_key_table", "ALT_KEY_TABLE"),
+    ("numeric", "numeric_key_table", "NUMERIC_KEY_TABLE"),
+    ("command", "command_key_table", "COMMAND_KEY_TABLE"),
+]
+
+MODIFIERS = {
+    "shift": "KEY_MOD_LSHIFT",
+    "ctrl": "KEY_MOD_LCTRL",
+    "alt": "KEY_MOD_LALT",
+    "gui": "KEY_MOD_LMETA",
+}
+
+MODES = {"wait": "CODE_WAIT", "speculate": "CODE_SPECULATE"}
+
+# keys typed by the characters of a macro, shifted characters are typed with KEY_MOD_LSHIFT
+MACRO_KEYS = {" ": "KEY_SPACE", ".": "KEY_DOT", ",": "KEY_COMMA", "-": "KEY_MINUS", "/": "KEY_SLASH",
+              ";": "KEY_SEMICOLON", "'": "KEY_APOSTROPHE", "=": "KEY_EQUAL"}
+MACRO_SHIFTED = {"?": "KEY_SLASH", ":": "KEY_SEMICOLON", "_": "KEY_MINUS", "(": "KEY_9", ")": "KEY_0",
+                 "@": "KEY_2", "!": "KEY_1", "&": "KEY_7", '"': "KEY_APOSTROPHE", "+": "KEY_EQUAL",
+                 "$": "KEY_4", "#": "KEY_3", "%": "KEY_5", "*": "KEY_8"}
+
+LINE = re.compile(r"^(?P<code>[.-]+)\s+(?P<key>\w+)(?P<rest>[^#]*?)\s*(#\s*(?P<description>.*?))?\s*$")
+LAYER = re.compile(r"^layer\s+(?P<name>\w+)\s+(?P<mode>\w+)\s*(#.*)?$")
+MACRO = re.compile(r'^macro\s+(?P<code>[.-]+)\s+"(?P<text>[^"]+)"\s*(#\s*(?P<description>.*?))?\s*$')
+
+
+class Entry:
+    def __init__(self, line, number, code, key, modifiers, mode, description):
+        self.line = line                # where the entry is, for messages
+        self.number = number            # line number in the keymap
+        self.code = code                # dots and dashes
+        self.key = key
+        self.modifiers = modifiers      # KEY_MOD_* names
+        self.mode = mode                # CODE_WAIT or CODE_SPECULATE if a longer code starts with it
+        self.description = description
+
+
+class Keymap:
+    def __init__(self):
+        self.layers = {name: [] for name, _, _ in LAYERS}
+        self.macros = []                # (line, code, text, description)
+        self.errors = []
+        self.warnings = []
+
+
+def code_value(code):
+    """Code as stored in the tables: the first element in the lowest bit, then the end marker."""
+    value = 1 << len(code)
+    for i, element in enumerate(code):
+        if element == "-":
+            value |= 1 << i
+    return value
+
+
+def read_names(path, prefix):
+    names = set()
+    if os.path.exists(path):
+        with open(path) as f:
+            for line in f:
+                match = re.match(r"\s*#define\s+(%s\w*)\s" % prefix, line)
+                if match:
+                    names.add(match.group(1))
+    return names
+
+
+def parse(path, lines=None):
+    """Read a keymap (or lines of one read from path), errors are collected in the keymap rather
+    than stopping at the first."""
+    keymap = Keymap()
+    base = os.path.dirname(os.path.abspath(path))
+    keys = read_names(os.path.join(base, "usb_hid_keys.h"), "KEY_")
+    functions = read_names(os.path.join(base, "codes.h"), "FN_")
+    layer = None
+    default_mode = None
+
+    if lines is None:
+        with open(path) as f:
+            lines = f.read().split("\n")
+    for number, text in enumerate(lines, 1):
+        text = text.strip()
+        where = "%s:%d" % (path, number)
+        if not text or text.startswith("#"):
+            continue
+
+        match = LAYER.match(text)
+        if match:
+            if match.group("name") not in keymap.layers:
+                keymap.errors.append("%s: unknown layer %s" % (where, match.group("name")))
+                layer = None
+                continue
+            if match.group("mode") not in MODES:
+                keymap.errors.append("%s: a layer's codes must wait or speculate" % where)
+            layer = match.group("name")
+            default_mode = MODES.get(match.group("mode"), "CODE_WAIT")
+            continue
+
+        match = MACRO.match(text)
+        if match:
+            keymap.macros.append((where, match.group("code"), match.group("text"), match.group("description")))
+            continue
+
+        match = LINE.match(text)
+        if not match:
+            keymap.errors.append("%s: can't read %r" % (where, text))
+            continue
+        if layer is None:
+            keymap.errors.append("%s: code before a layer" % where)
+            continue
+
+        key = match.group("key")
+        if key not in keys and key not in functions:
+            keymap.errors.append("%s: unknown key or device function %s" % (where, key))
+        modifiers = []
+        mode = default_mode
+        for word in match.group("rest").split():
+            if word in MODES:
+                mode = MODES[word]
+            elif word in MODIFIERS:
+                modifiers.append(MODIFIERS[word])
+            elif word.startswith("KEY_MOD_") and word in keys:
+                modifiers.append(word)
+            else:
+                keymap.errors.append("%s: unknown modifier %s" % (where, word))
+        keymap.layers[layer].append(Entry(where, number, match.group("code"), key, modifiers, mode,
+                                          match.group("description") or ""))
+    return keymap
+
+
+def macro_keys(text):
+    keys = []
+    for c in text:
+        if c.isalpha() and c.isascii():
+            keys.append(("KEY_MOD_LSHIFT" if c.isupper() else "0", "KEY_" + c.upper()))
+        elif c.isdigit():
+            keys.append(("0", "KEY_" + c))
+        elif c in MACRO_KEYS:
+            keys.append(("0", MACRO_KEYS[c]))
+        elif c in MACRO_SHIFTED:
+            keys.append(("KEY_MOD_LSHIFT", MACRO_SHIFTED[c]))
+        else:
+            return None
+    return keys
+
+
+def check(keymap):
+    for name, entries in keymap.layers.items():
+        if len(entries) >= NO_ENTRY:
+            keymap.errors.append("%s layer has more than %d codes" % (name, NO_ENTRY - 1))
+        seen = {}
+        keys = {}
+        for entry in entries:
+            if len(entry.code) > MAX_CODE_SIZE:
+                keymap.errors.append("%s: %s is longer than MAX_CODE_SIZE (%d)" % (entry.line, entry.code, MAX_CODE_SIZE))
+            if entry.code in seen:
+                keymap.errors.append("%s: %s is already used in the %s layer by %s" % (entry.line, entry.code, name, seen[entry.code]))
+            seen.setdefault(entry.code, entry.line)
+            typed = (entry.key, tuple(sorted(entry.modifiers)))
+            if typed in keys:
+                keymap.warnings.append("%s: %s is also typed by %s" % (entry.line, entry.key, keys[typed]))
+            keys.setdefault(typed, entry.code)
+
+    # macros share the alt codes, an alt key would hide the macro
+    alt_codes = {entry.code: entry.line for entry in keymap.layers["alt"]}
+    seen = {}
+    for where, code, text, _ in keymap.macros:
+        if code in alt_codes:
+            keymap.errors.append("%s: macro %s is on the alt code of %s" % (where, code, alt_codes[code]))
+        if code in seen:
+            keymap.errors.append("%s: macro %s is already used by %s" % (where, code, seen[code]))
+        seen.setdefault(code, where)
+        if len(code) > MAX_CODE_SIZE:
+            keymap.errors.append("%s: macro %s is longer than MAX_CODE_SIZE (%d)" % (where, code, MAX_CODE_SIZE))
+        keys = macro_keys(text)
+        if keys is None:
+            keymap.errors.append("%s: macro %r has a character that can't be typed" % (where, text))
+        elif len(keys) > SEND_KEYS_MAX:
+            keymap.errors.append("%s: macro is longer than SEND_KEYS_MAX (%d keys)" % (where, SEND_KEYS_MAX))
+
+
+def mode(entry, entries):
+    extended = any((other.code != entry.code) and other.code.startswith(entry.code) for other in entries)
+    return entry.mode if extended else "CODE_LEAF"
+
+
+def report(keymap):
+    flash = 0
+    for name, table, _ in LAYERS:
+        entries = keymap.layers[name]
+        used = {entry.code for entry in entries}
+        if name == "alt":
+            used |= {code for _, code, _, _ in keymap.macros}
+        longest = max((len(entry.code) for entry in entries), default=0)
+        short = [code for code in all_codes(SHORT_CODE_SIZE) if code not in used]
+        flash += (len(entries) * 8) + (1 << (longest + 1))
+        if name in CORRECTED_LAYERS:
+            flash += 1 << (CORRECTION_MAX_CODE_SIZE + 1)
+        sys.stderr.write("%-9s %3d codes, longest %d, %2d unused up to %d elements: %s\n"
+                         % (name, len(entries), longest, len(short), SHORT_CODE_SIZE, " ".join(short)))
+    macro_bytes = sum(3 + 2 * len(macro_keys(text)) for _, _, text, _ in keymap.macros)
+    sys.stderr.write("%d macros, %d bytes of flash for the tables and macros\n" % (len(keymap.macros), flash + macro_bytes))
+
+
+def all_codes(longest):
+    codes = [""]
+    result = []
+    for _ in range(longest):
+        codes = [code + element for code in codes for element in ".-"]
+        result.extend(codes)
+    return result
+
+
+def code_distance(entered, target):
+    """Weighted edit distance between two codes, extra or missing elements at either end are cheap
+    as they are the usual result of a bumped or missed press."""
+    n, m = len(entered), len(target)
+    dist = [[0] * (m + 1) for _ in range(n + 1)]
+    for i in range(n + 1):
+        for j in range(m + 1):
+            if i == 0 and j == 0:
+                continue
+            best = []
+            if i > 0:
+                # extra element entered
+                best.append(dist[i - 1][j] + (EDIT_COST_END if i in (1, n) else EDIT_COST_MIDDLE))
+            if j > 0:
+                # element missing from what was entered
+                best.append(dist[i][j - 1] + (EDIT_COST_END if i in (0, n) else EDIT_COST_MIDDLE))
+            if i > 0 and j > 0:
+                best.append(dist[i - 1][j - 1] + (0 if entered[i - 1] == target[j - 1] else EDIT_COST_SUBSTITUTE))
+            dist[i][j] = min(best)
+    return dist[n][m]
+
+
+def nearest_index(entries):
+    """Nearest entry for every code up to CORRECTION_MAX_CODE_SIZE long, only codes with a single
+    clear nearest entry are corrected."""
+    index = [NO_ENTRY] * (1 << (CORRECTION_MAX_CODE_SIZE + 1))
+    for code in [""] + all_codes(CORRECTION_MAX_CODE_SIZE):
+        distances = sorted((code_distance(code, entry.code), i) for i, entry in enumerate(entries))
+        best = distances[0] if distances else (NO_ENTRY, NO_ENTRY)
+        second = distances[1][0] if len(distances) > 1 else NO_ENTRY
+        if (best[0] <= CORRECTION_MAX_COST) and ((second - best[0]) >= CORRECTION_MIN_MARGIN):
+            index[code_value(code)] = best[1]
+    return index
+
+
+def write_index(out, name, size, index):
+    out.append("")
+    out.append("static const uint8_t %s[%s] =" % (name, size))
+    out.append("{")
+    for i in range(0, len(index), 16):
+        out.append("    " + ", ".join("0x%02x" % v for v in index[i:i + 16]) + ",")
+    out.append("};")
+
+
+def c_literal(code):
+    return "0b{:b}".format(code_value(code))
+
+
+def write(keymap, source):
+    out = []
+    out.append("// Generated by tools/make_keymap.py from %s, do not edit" % os.path.basename(source))
+    out.append("")
+    out.append("#ifndef KEYMAP_DATA_H")
+    out.append("#define KEYMAP_DATA_H")
+    out.append("")
+    for name, table, size in LAYERS:
+        out.append("#define %-32s %d" % (size + "_SIZE", len(keymap.layers[name])))
+    for name, table, size in LAYERS:
+        longest = max((len(entry.code) for entry in keymap.layers[name]), default=0)
+        out.append("#define %-32s %d" % (size + "_INDEX_SIZE", 1 << (longest + 1)))
+    out.append("#define %-32s %d" % ("CORRECTION_MAX_CODE_SIZE", CORRECTION_MAX_CODE_SIZE))
+    out.append("#define %-32s %d" % ("CORRECTION_INDEX_SIZE", 1 << (CORRECTION_MAX_CODE_SIZE + 1)))
+
+    for name, table, size in LAYERS:
+        entries = keymap.layers[name]
+        out.append("")
+        out.append("static const uint16_t %s[%s_SIZE][4] =" % (table, size))
+        out.append("{")
+        for i, entry in enumerate(entries):
+            modifiers = " | ".join(entry.modifiers) or "0"
+            line = " {%-13s %-17s %-15s %-15s}" % (c_literal(entry.code) + ",", entry.key + ",", modifiers + ",",
+                                                   mode(entry, entries))
+            line += "," if i < len(entries) - 1 else " "
+            out.append("%s // %s" % (line, entry.description or entry.code))
+        out.append("};")
+
+        index = [NO_ENTRY] * (1 << (max((len(entry.code) for entry in entries), default=0) + 1))
+        for i, entry in enumerate(entries):
+            index[code_value(entry.code)] = i
+        write_index(out, table + "_index", size + "_INDEX_SIZE", index)
+
+        if name in CORRECTED_LAYERS:
+            write_index(out, table + "_nearest", "CORRECTION_INDEX_SIZE", nearest_index(entries))
+
+    out.append("")
+    out.append("static const uint8_t default_macro_table[] =")
+    out.append("{")
+    for _, code, text, description in keymap.macros:
+        keys = macro_keys(text)
+        line = " MACRO_CODE(%s), %d," % (c_literal(code), len(keys))
+        out.append("%-86s // %s (alt %s)" % (line, description or text, code))
+        out.append("   " + "  ".join("%s, %s," % key for key in keys))
+    out.append("};")
+    out.append("")
+    out.append("#endif // KEYMAP_DATA_H")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+
+    keymap = parse(sys.argv[1])
+    check(keymap)
+    for warning in keymap.warnings:
+        sys.stderr.write("warning: %s\n" % warning)
+    if keymap.errors:
+        sys.exit("\n".join(keymap.errors))
+    report(keymap)
+    sys.stdout.write(write(keymap, sys.argv[1]))
+
+
+if __name__ == "__main__":
+    main()
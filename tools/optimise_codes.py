@@ -0,0 +1,294 @@
+#!/usr/bin/env python3
+"""
+Search for standard layer codes that make a text corpus quicker to type, and write the keymap
+with them.
+
+Typing a character takes its elements, then a pause: a code no longer code starts with
+(CODE_LEAF) is sent as soon as it is entered and the next code can start after the normal gap,
+any other code is only ended by waiting ADVANCE_TIME. The expected time a character, for the
+character frequencies of the corpus, is
+
+  sum of p(c) * (elements(c) * press + (elements(c) - 1) * gap + (gap if a leaf else advance))
+
+so the search trades shorter codes against codes that need the timeout. With -p every code must
+be a leaf (the table is prefix-free and no character waits for the timeout), the best such table
+is length limited Huffman codes so no search is needed.
+
+The search is simulated annealing, moving a character to an unused code or swapping the codes of
+two characters, run from a different start in each worker process and the best table kept (the
+current table, the best prefix-free table, then random tables). With -l the letters keep their
+International Morse codes and only the digits and punctuation move.
+
+Only the codes of the standard layer change, every other line of keymap.txt is copied (each
+entry's description must be the character it types). The keymap written is checked as
+make_keymap.py checks it, which works out the new codes' modes, and the expected time a
+character is reported on stderr for the current and the new codes.
+
+usage: optimise_codes.py [-l] [-p] [-t press,gap,advance] [-m max_len] [-r restarts] [-n steps]
+                         [-j jobs] keymap.txt corpus.txt... > keymap_new.txt
+"""
+
+import argparse
+import math
+import multiprocessing
+import random
+import re
+import sys
+
+import make_keymap
+
+LETTERS = set("abcdefghijklmnopqrstuvwxyz")
+UNUSED_WEIGHT = 1e-6           # frequency given to characters not in the corpus, so they still get a code
+
+OPTIMISED_NOTE = "# codes chosen by tools/optimise_codes.py"
+
+
+def code_length(code):
+    return code.bit_length() - 1
+
+
+def code_text(code):
+    return "".join("-" if (code >> i) & 1 else "." for i in range(code_length(code)))
+
+
+def parent(code):
+    length = code_length(code) - 1
+    return (code & ((1 << length) - 1)) | (1 << length)
+
+
+def ancestors(code):
+    while code_length(code) > 1:
+        code = parent(code)
+        yield code
+
+
+def read_frequencies(paths, symbols):
+    counts = dict.fromkeys(symbols, 0)
+    other = 0
+    for path in paths:
+        with open(path) as f:
+            for c in f.read():
+                c = c.lower()
+                if c in counts:
+                    counts[c] += 1
+                else:
+                    other += 1
+    total = sum(counts.values())
+    if total == 0:
+        sys.exit("no characters of the standard layer in the corpus")
+    return [max(counts[s] / total, UNUSED_WEIGHT) for s in symbols], total, other
+
+
+class Table:
+    """Codes of the characters, with the number of codes below each code so a leaf is known."""
+
+    def __init__(self, codes, weights, timing):
+        self.codes = list(codes)
+        self.weights = weights
+        self.press, self.gap, self.advance = timing
+        self.owner = {code: s for s, code in enumerate(self.codes)}
+        self.below = {}
+        for code in self.codes:
+            for a in ancestors(code):
+                self.below[a] = self.below.get(a, 0) + 1
+
+    def time(self, code):
+        elements = code_length(code)
+        leaf = self.below.get(code, 0) == 0
+        return elements * self.press + (elements - 1) * self.gap + (self.gap if leaf else self.advance)
+
+    def cost(self):
+        return sum(w * self.time(code) for w, code in zip(self.weights, self.codes))
+
+    def swap_delta(self, s, t):
+        cs, ct = self.codes[s], self.codes[t]
+        return (self.weights[s] - self.weights[t]) * (self.time(ct) - self.time(cs))
+
+    def swap(self, s, t):
+        self.codes[s], self.codes[t] = self.codes[t], self.codes[s]
+        self.owner[self.codes[s]] = s
+        self.owner[self.codes[t]] = t
+
+    def affected(self, s, code):
+        # characters whose time can change when s moves to or from code
+        owners = {s}
+        for a in ancestors(code):
+            if a in self.owner:
+                owners.add(self.owner[a])
+        return owners
+
+    def move(self, s, code):
+        old = self.codes[s]
+        for a in ancestors(old):
+            self.below[a] -= 1
+        for a in ancestors(code):
+            self.below[a] = self.below.get(a, 0) + 1
+        del self.owner[old]
+        self.owner[code] = s
+        self.codes[s] = code
+        return old
+
+    def move_delta(self, s, code):
+        owners = self.affected(s, self.codes[s]) | self.affected(s, code)
+        before = sum(self.weights[o] * self.time(self.codes[o]) for o in owners)
+        old = self.move(s, code)
+        after = sum(self.weights[o] * self.time(self.codes[o]) for o in owners)
+        return after - before, old
+
+
+def prefix_free_codes(weights, max_len):
+    """Codes of least expected length with none starting with another (length limited Huffman codes
+    from package-merge, given out in canonical order)."""
+    items = sorted((w, (s,)) for s, w in enumerate(weights))
+    packages = list(items)
+    for _ in range(max_len - 1):
+        pairs = [(packages[i][0] + packages[i + 1][0], packages[i][1] + packages[i + 1][1])
+                 for i in range(0, len(packages) - 1, 2)]
+        packages = sorted(items + pairs)
+    lengths = [0] * len(weights)
+    for _, symbols in packages[:(2 * len(weights)) - 2]:
+        for s in symbols:
+            lengths[s] += 1
+
+    codes = [0] * len(weights)
+    value = 0
+    last = 0
+    for s in sorted(range(len(weights)), key=lambda s: (lengths[s], s)):
+        value <<= lengths[s] - last
+        last = lengths[s]
+        # first element in the lowest bit, then the end marker
+        codes[s] = int("{:0{}b}".format(value, last)[::-1], 2) | (1 << last)
+        value += 1
+    return codes
+
+
+def anneal(job):
+    seed, codes, weights, movable, timing, max_len, steps = job
+    rng = random.Random(seed)
+    table = Table(codes, weights, timing)
+    all_codes = [(1 << length) | bits for length in range(1, max_len + 1) for bits in range(1 << length)]
+
+    if (seed == 1) and (len(movable) == len(codes)):
+        # the second worker starts from the best prefix-free table
+        table = Table(prefix_free_codes(weights, max_len), weights, timing)
+    elif seed > 0:
+        # the rest start from a random table
+        for _ in range(len(movable) * 4):
+            s = rng.choice(movable)
+            code = rng.choice(all_codes)
+            if code not in table.owner:
+                table.move(s, code)
+
+    cost = table.cost()
+    best = (cost, list(table.codes))
+    start_temp = table.press + table.gap
+    for step in range(steps):
+        temp = start_temp * math.pow(1e-4, step / steps)
+        s = rng.choice(movable)
+        if (len(movable) > 1) and (rng.random() < 0.5):
+            t = rng.choice(movable)
+            delta = table.swap_delta(s, t)
+            if (delta <= 0) or (rng.random() < math.exp(-delta / temp)):
+                table.swap(s, t)
+                cost += delta
+        else:
+            code = rng.choice(all_codes)
+            if code in table.owner:
+                continue
+            delta, old = table.move_delta(s, code)
+            if (delta <= 0) or (rng.random() < math.exp(-delta / temp)):
+                cost += delta
+            else:
+                table.move(s, old)
+        if cost < best[0] - 1e-9:
+            best = (cost, list(table.codes))
+    # the running cost drifts with rounding, so score the best table again
+    return Table(best[1], weights, timing).cost(), best[1]
+
+
+def report(name, table):
+    elements = sum(w * code_length(code) for w, code in zip(table.weights, table.codes))
+    timeouts = sum(w for w, code in zip(table.weights, table.codes) if table.below.get(code, 0) > 0)
+    sys.stderr.write("%-9s %5.2f elements, %4.2f timeouts, %6.1f ms a character\n"
+                     % (name, elements, timeouts, table.cost()))
+
+
+def main():
+    parser = argparse.ArgumentParser(usage=__doc__.split("usage: ")[1])
+    parser.add_argument("-l", action="store_true", help="keep the letters' International Morse codes")
+    parser.add_argument("-p", action="store_true", help="make every code a leaf")
+    parser.add_argument("-t", default="80,80,200", help="operator press and gap times and ADVANCE_TIME (in ms)")
+    parser.add_argument("-m", type=int, default=make_keymap.CORRECTION_MAX_CODE_SIZE, help="longest code")
+    parser.add_argument("-r", type=int, default=16, help="restarts")
+    parser.add_argument("-n", type=int, default=200000, help="steps each restart")
+    parser.add_argument("-j", type=int, default=multiprocessing.cpu_count(), help="worker processes")
+    parser.add_argument("keymap")
+    parser.add_argument("corpus", nargs="+")
+    args = parser.parse_args()
+
+    timing = tuple(int(v) for v in args.t.split(","))
+    if len(timing) != 3:
+        sys.exit("-t needs press,gap,advance")
+    if not 1 <= args.m <= make_keymap.MAX_CODE_SIZE:
+        sys.exit("-m must be 1 to %d" % make_keymap.MAX_CODE_SIZE)
+    if args.m > make_keymap.CORRECTION_MAX_CODE_SIZE:
+        sys.stderr.write("codes longer than %d elements won't be corrected\n" % make_keymap.CORRECTION_MAX_CODE_SIZE)
+
+    with open(args.keymap) as f:
+        lines = f.read().split("\n")
+    keymap = make_keymap.parse(args.keymap, lines)
+    if keymap.errors:
+        sys.exit("\n".join(keymap.errors))
+    entries = keymap.layers["standard"]
+    symbols = [entry.description for entry in entries]
+    codes = [make_keymap.code_value(entry.code) for entry in entries]
+    if len(set(symbols)) != len(symbols) or any(len(s) != 1 for s in symbols):
+        sys.exit("each standard layer entry needs its character as its description")
+    weights, total, other = read_frequencies(args.corpus, symbols)
+    movable = [s for s, symbol in enumerate(symbols) if not (args.l and symbol in LETTERS)]
+    if args.l and args.p:
+        sys.exit("the letters' codes aren't prefix-free, -l and -p can't be used together")
+    if len(movable) > (1 << (args.m + 1)) - 2 - (len(symbols) - len(movable)):
+        sys.exit("not enough codes of up to %d elements" % args.m)
+    sys.stderr.write("%d characters of the standard layer in the corpus (%d others ignored)\n" % (total, other))
+
+    if args.p:
+        # the best prefix-free table is known without a search
+        best = prefix_free_codes(weights, args.m)
+        cost = Table(best, weights, timing).cost()
+    else:
+        jobs = [(seed, codes, weights, movable, timing, args.m, args.n) for seed in range(args.r)]
+        with multiprocessing.Pool(args.j) as pool:
+            cost, best = min(pool.map(anneal, jobs))
+
+    current = Table(codes, weights, timing)
+    optimised = Table(best, weights, timing)
+    report("current", current)
+    report("optimised", optimised)
+
+    for entry, symbol, old, code in zip(entries, symbols, codes, best):
+        # the code is replaced in place, keeping the key in its column
+        line = lines[entry.number - 1]
+        match = re.match(r"^(\s*)([.-]+)(\s+)", line)
+        width = len(match.group(2) + match.group(3))
+        lines[entry.number - 1] = match.group(1) + code_text(code).ljust(max(width, code_length(code) + 1)) + line[match.end():]
+        if code != old:
+            sys.stderr.write("  %s %-10s -> %s\n" % (symbol, code_text(old), code_text(code)))
+
+    # note how the codes were chosen just above the layer, replacing the note of an earlier run
+    start = next(i for i, line in enumerate(lines) if re.match(r"\s*layer\s+standard\s", line))
+    if lines[start - 1].startswith(OPTIMISED_NOTE):
+        del lines[start - 1]
+        start -= 1
+    kind = "letters kept" if args.l else ("prefix-free" if args.p else "all codes")
+    lines.insert(start, "%s (%s, %.1f ms a character)" % (OPTIMISED_NOTE, kind, cost))
+
+    keymap = make_keymap.parse(args.keymap, lines)
+    make_keymap.check(keymap)
+    if keymap.errors:
+        sys.exit("keymap written is invalid:\n  " + "\n  ".join(keymap.errors))
+    sys.stdout.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,248 @@
+#include <stdint.h>
+#include <string.h>
+#include "nordic_common.h"
+#include "nrf.h"
+#include "SEGGER_RTT.h"
+
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_default_backends.h"
+
+#include "common.h"
+
+#define TRACE_BUFFER_SIZE                   2048          // RAM kept for edges, the oldest are lost once it is full
+#define TRACE_RTT_CHANNEL                   1             // RTT up channel the trace is dumped on (channel 0 is the log)
+#define TRACE_RTT_BUFFER_SIZE               256
+#define TRACE_DUMP_CHUNK                    64            // most bytes written to RTT each poll cycle
+#define TRACE_DUMP_TIMEOUT                  100           // poll cycles without the RTT buffer being read before a dump is given up
+#define TRACE_MAX_RECORD                    6             // longest encoded edge (a header byte and a 5 byte delta)
+
+/*
+ * Press trace, every change in the reading of a button seen by the debouncer is recorded so that
+ * a session can be replayed through the decoder on a host (host/_build/trace). The readings rather
+ * than the debounced presses are kept, so the replay is exact and the debounce settings can be
+ * changed when it is replayed.
+ *
+ * Trace format, all values low byte first:
+ * [1] header of TRACE_HEADER_SIZE bytes: 'M', 'T', TRACE_VERSION, button readings before the first
+ *     edge (a bit for each enum board_key), poll count the first delta is from (4 bytes) and the
+ *     number of edge bytes that follow (2 bytes)
+ * [2] one byte for each edge: the button in bits 0-1, 1 in bit 2 if it went down and the poll
+ *     cycles since the last edge in bits 3-7, if that is TRACE_DELTA_ESCAPE the rest of the delta
+ *     (less TRACE_DELTA_ESCAPE) follows 7 bits a byte, with bit 7 set in all but the last byte
+ *
+ * The trace is dumped on its own RTT channel with the device command, e.g.
+ * JLinkRTTLogger -Device NRF52832_XXAA -If SWD -Speed 4000 -RTTChannel 1 session.trace
+ */
+
+// Edges recorded, a ring of whole records
+static uint8_t trace_buffer[PRESS_TRACE_MODE ? TRACE_BUFFER_SIZE : 1];
+static uint16_t trace_rp = 0;
+static uint16_t trace_len = 0;
+
+static uint32_t trace_start_time = 0;            // poll count the first record's delta is from
+static uint8_t trace_start_state = 0;            // button readings before the first record
+static uint32_t trace_last_time = 0;             // poll count of the last record
+static uint8_t trace_state = 0;                  // current button readings
+
+static uint8_t rtt_buffer[PRESS_TRACE_MODE ? TRACE_RTT_BUFFER_SIZE : 1];
+static bool dumping = false;                     // recording stops while the trace is dumped
+static uint16_t dump_offset = 0;
+static uint8_t dump_stalled = 0;                 // poll cycles since the last part of the dump was written
+
+
+static uint8_t trace_byte(uint16_t index)
+{
+	return trace_buffer[(trace_rp + index) % TRACE_BUFFER_SIZE];
+}
+
+
+// remove the oldest record, moving the start of the trace on to its time and state
+static void drop_oldest(void)
+{
+	uint8_t header = trace_byte(0);
+	uint32_t delta = header >> 3;
+	uint16_t len = 1;
+
+	if (delta == TRACE_DELTA_ESCAPE)
+	{
+		uint8_t shift = 0;
+		uint8_t value;
+		do
+		{
+			value = trace_byte(len++);
+			delta += (uint32_t)(value & 0x7F) << shift;
+			shift += 7;
+		} while (value & 0x80);
+	}
+
+	trace_start_time += delta;
+	if (header & 0x04)
+	{
+		trace_start_state |= 1 << (header & 0x03);
+	}
+	else
+	{
+		trace_start_state &= ~(1 << (header & 0x03));
+	}
+
+	trace_rp = (trace_rp + len) % TRACE_BUFFER_SIZE;
+	trace_len -= len;
+}
+
+
+// Function for starting a new trace from the current button readings
+void trace_init(void)
+{
+	trace_rp = 0;
+	trace_len = 0;
+	trace_start_time = trace_last_time;
+	trace_start_state = trace_state;
+	dumping = false;
+
+	if (PRESS_TRACE_MODE)
+	{
+		UNUSED_RETURN_VALUE(SEGGER_RTT_ConfigUpBuffer(TRACE_RTT_CHANNEL, "Trace", rtt_buffer, sizeof(rtt_buffer),
+													  SEGGER_RTT_MODE_NO_BLOCK_SKIP));
+	}
+}
+
+
+/**@brief Function for recording a change in the reading of a button.
+ *
+ * @param[in]   key    Button read.
+ * @param[in]   down   New reading.
+ * @param[in]   time   Poll count of the reading.
+ */
+void trace_edge(enum board_key key, bool down, uint32_t time)
+{
+	uint8_t record[TRACE_MAX_RECORD];
+	uint8_t len = 1;
+	uint32_t delta = time - trace_last_time;
+
+	if (down)
+	{
+		trace_state |= 1 << key;
+	}
+	else
+	{
+		trace_state &= ~(1 << key);
+	}
+	trace_last_time = time;
+
+	if (dumping)
+	{
+		return;
+	}
+
+	if (delta < TRACE_DELTA_ESCAPE)
+	{
+		record[0] = (delta << 3) | (down << 2) | key;
+	}
+	else
+	{
+		record[0] = (TRACE_DELTA_ESCAPE << 3) | (down << 2) | key;
+		delta -= TRACE_DELTA_ESCAPE;
+		do
+		{
+			record[len] = delta & 0x7F;
+			delta >>= 7;
+			if (delta > 0)
+			{
+				record[len] |= 0x80;
+			}
+			len++;
+		} while (delta > 0);
+	}
+
+	while ((TRACE_BUFFER_SIZE - trace_len) < len)
+	{
+		drop_oldest();
+	}
+	for (uint8_t i = 0; i < len; i++)
+	{
+		trace_buffer[(trace_rp + trace_len++) % TRACE_BUFFER_SIZE] = record[i];
+	}
+}
+
+
+// size of the trace with its header (in bytes)
+uint16_t trace_size(void)
+{
+	return TRACE_HEADER_SIZE + trace_len;
+}
+
+
+/**@brief Function for reading part of the trace, as it is dumped.
+ *
+ * @param[in]   offset   Position in the trace, from the start of the header.
+ * @param[out]  p_data   Buffer for the bytes read.
+ * @param[in]   len      Most bytes to read.
+ *
+ * @return      Number of bytes read, 0 at the end of the trace.
+ */
+uint16_t trace_read(uint16_t offset, uint8_t * p_data, uint16_t len)
+{
+	uint8_t header[TRACE_HEADER_SIZE] =
+	{
+		'M', 'T', TRACE_VERSION, trace_start_state,
+		trace_start_time & 0xFF, (trace_start_time >> 8) & 0xFF, (trace_start_time >> 16) & 0xFF, trace_start_time >> 24,
+		trace_len & 0xFF, trace_len >> 8
+	};
+	uint16_t count = 0;
+
+	for (; (count < len) && (offset < trace_size()); count++, offset++)
+	{
+		p_data[count] = (offset < TRACE_HEADER_SIZE) ? header[offset] : trace_byte(offset - TRACE_HEADER_SIZE);
+	}
+	return count;
+}
+
+
+// start writing the trace to RTT, recording stops until it has all been written
+void trace_dump_start(void)
+{
+	if (!PRESS_TRACE_MODE)
+	{
+		return;
+	}
+	NRF_LOG_INFO("Trace Dump: %d bytes", trace_size());
+	dumping = true;
+	dump_offset = 0;
+	dump_stalled = 0;
+}
+
+
+// write the next part of a dump, called every poll cycle
+void trace_poll(void)
+{
+	uint8_t chunk[TRACE_DUMP_CHUNK];
+	uint16_t len;
+
+	if (!dumping)
+	{
+		return;
+	}
+
+	len = trace_read(dump_offset, chunk, sizeof(chunk));
+	if (len == 0)
+	{
+		// the trace carries on from the edges seen while dumping
+		NRF_LOG_INFO("Trace Dump: done");
+		trace_init();
+		return;
+	}
+
+	// the RTT buffer is skipped rather than waited for when it is full, so try again next time, and
+	// give up if nothing is reading it (recording carries on with the trace kept)
+	if (SEGGER_RTT_Write(TRACE_RTT_CHANNEL, chunk, len) == len)
+	{
+		dump_offset += len;
+		dump_stalled = 0;
+	}
+	else if (++dump_stalled >= TRACE_DUMP_TIMEOUT)
+	{
+		NRF_LOG_WARNING("Trace Dump: not read");
+		dumping = false;
+	}
+}